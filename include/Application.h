@@ -10,7 +10,7 @@
 
 #include "GarageControl.h"
 #include "HormannUAP1WithSwitch.h"
-#include "logging.h"
+#include "Logging.h"
 #include "WiFiService.h"
 
 class Application
@@ -27,4 +27,13 @@ private:
 	static void setLED ();
 	static void multicastMsg ( UDPWiFiService::ReqMsgType eReqType );
 	static void processUDPMsg ( UDPWiFiService::ReqMsgType eReqType );
+
+	// Scheduler tasks registered in begin(); static to fit Scheduler::TaskFunction.
+	static void taskLED ();
+	static void taskOnboarding ();
+	static void taskUDP ();
+	static void taskSensor ();
+	static void taskDisplay ();
+	static void taskDoor ();
+	static void taskSendQueue ();
 };
@@ -14,6 +14,7 @@
 #include "IEnvironmentSensor.h"
 #include "IGarageDoor.h"
 #include "Logging.h"
+#include "Scheduler.h"
 #include "WiFiService.h"
 
 // ─── Display class ────────────────────────────────────────────────────────────
@@ -27,27 +28,43 @@ public:
 	 * @param version     Software version string shown on the status screen.
 	 * @param pDoor       Garage door; may be nullptr (no door configured).
 	 * @param pSensor     Environment sensor; may be nullptr (not present).
+	 * @param pScheduler  Loop scheduler whose task statistics are shown; may be nullptr.
 	 */
 	Display ( ansiVT220Logger& logger,
 	          UDPWiFiService* pUDPService,
 	          const char* version,
 	          IGarageDoor* pDoor,
-	          IEnvironmentSensor* pSensor );
+	          IEnvironmentSensor* pSensor,
+	          const Scheduler* pScheduler = nullptr );
 
-	// Refresh the full debug status screen (call ~500 ms from loop()).
+	// Refresh the full debug status screen (call ~500 ms from loop()). Does nothing
+	// while no client is connected or the client has not taken the last frame yet.
 	void DisplayStats ();
 
 	// Display the network-status block only.
 	void DisplayNWStatus ();
 
+	// Time since construction; correct across millis() wraps as long as DisplayStats() is
+	// called at least once per wrap.
+	uint64_t GetUptimeMs () const;
+
 private:
 	ansiVT220Logger& m_logger;
 	UDPWiFiService* m_pUDPService;
 	const char* m_version;
 	IGarageDoor* m_pDoor;
 	IEnvironmentSensor* m_pSensor;
+	const Scheduler* m_pScheduler;
+	uint32_t m_ulStartMs;                // millis() at construction, for the uptime
+	uint32_t m_ulLastMs;                 // millis() at the last DisplayStats() call
+	uint32_t m_ulMillisWraps = 0UL;      // millis() wraps since construction
+	bool m_bRepaintDue = true;           // clear and redraw everything on the next frame
+	uint32_t m_ulSkippedFrames = 0UL;    // frames skipped because the client was still busy
 
+	void TrackMillisWrap ();
 	void DisplayUptime ( uint8_t line, uint8_t row, ansiVT220Logger::colours fg, ansiVT220Logger::colours bg );
+	void DisplayLoopProfile ();
+	void DisplaySchedulerStats ();
 };
 
 // ─── Notification-bar free functions ─────────────────────────────────────────
@@ -0,0 +1,255 @@
+#pragma once
+/*
+ * FixedIPSet.h
+ *
+ * Fixed-capacity set of IPv4 addresses, used by UDPWiFiService for the subnet
+ * broadcast addresses that multicasts are sent to.  Storage is a static table
+ * of SIZE slots (no heap) searched by open addressing: an address is hashed to
+ * a home slot and linear probing finds it or the first free slot, so lookups
+ * and inserts touch one or two slots rather than scanning the whole set.
+ * Removal shifts the following entries of the probe run back instead of
+ * leaving tombstones, so the table never needs rebuilding.  0.0.0.0 marks a
+ * free slot and cannot be stored.
+ *
+ * Each entry keeps the millis() it was last seen.  Expire() drops entries not
+ * seen for the lease, so a subnet whose clients have gone quiet stops being
+ * sent to; a pinned entry (the local subnet) never expires.  When the set is
+ * full a new address replaces the least recently seen unpinned entry.
+ *
+ * Each entry also carries a T, value-initialised when the address is added and
+ * moved with it, for whatever the owner tracks per address (UDPWiFiService
+ * keeps send health there).
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version, replaces FixedIPList
+ *   Ver 1.1   Per-entry value
+ *   Ver 1.2   Add() keeps an existing pin; Unpin()
+ *   Ver 1.3   GetUncountedIterator()
+ */
+
+#include <WiFiNINA.h>
+#include <stdint.h>
+
+template <uint8_t SIZE, typename T>
+class FixedIPSet
+{
+	static_assert ( SIZE >= 2 && SIZE <= 128 && ( SIZE & ( SIZE - 1 ) ) == 0, "SIZE must be a power of two up to 128" );
+
+public:
+	// Adds an address, or refreshes its last-seen time if already present.  bPinned pins the
+	// entry; an entry that is already pinned stays pinned until Unpin().  Returns false for
+	// 0.0.0.0, or when the set is full of pinned entries.
+	bool Add ( IPAddress addr, uint32_t nowMs, bool bPinned = false )
+	{
+		uint32_t key = (uint32_t)addr;
+		m_ulOperations++;
+		if ( key == 0UL )
+		{
+			return false;
+		}
+		int16_t slot = FindSlot ( key );
+		if ( slot < 0 )
+		{
+			if ( m_count == SIZE && !EvictOldest ( nowMs ) )
+			{
+				return false;
+			}
+			slot = Home ( key );
+			while ( m_keys [ slot ] != 0UL )
+			{
+				slot = ( slot + 1 ) & ( SIZE - 1 );
+			}
+			m_keys [ slot ] = key;
+			m_pinned [ slot ] = false;
+			m_values [ slot ] = T();
+			m_count++;
+		}
+		m_lastSeenMs [ slot ] = nowMs;
+		m_pinned [ slot ] = m_pinned [ slot ] || bPinned;
+		return true;
+	}
+
+	// Lets a pinned entry expire again, its lease starting now.  Returns false if the address is
+	// not in the set.
+	bool Unpin ( IPAddress addr, uint32_t nowMs )
+	{
+		m_ulOperations++;
+		int16_t slot = FindSlot ( (uint32_t)addr );
+		if ( slot < 0 )
+		{
+			return false;
+		}
+		m_pinned [ slot ] = false;
+		m_lastSeenMs [ slot ] = nowMs;
+		return true;
+	}
+
+	// Drops every unpinned entry not seen for leaseMs; returns how many were dropped.
+	uint8_t Expire ( uint32_t nowMs, uint32_t leaseMs )
+	{
+		m_ulOperations++;
+		uint8_t dropped = 0;
+		uint8_t slot = 0;
+		while ( slot < SIZE )
+		{
+			// Removal may shift a later entry into this slot, so only advance past a kept one.  An
+			// entry shifted back across the end of the table waits for the next call.
+			if ( m_keys [ slot ] != 0UL && !m_pinned [ slot ] && nowMs - m_lastSeenMs [ slot ] >= leaseMs )
+			{
+				RemoveAt ( slot );
+				dropped++;
+			}
+			else
+			{
+				slot++;
+			}
+		}
+		m_ulExpired += dropped;
+		return dropped;
+	}
+
+	bool Contains ( IPAddress addr ) const
+	{
+		return FindSlot ( (uint32_t)addr ) >= 0;
+	}
+
+	// The value stored with an address, or nullptr if the address is not in the set.
+	T* GetValue ( IPAddress addr )
+	{
+		int16_t slot = FindSlot ( (uint32_t)addr );
+		return slot < 0 ? nullptr : &m_values [ slot ];
+	}
+
+	const T* GetValue ( IPAddress addr ) const
+	{
+		int16_t slot = FindSlot ( (uint32_t)addr );
+		return slot < 0 ? nullptr : &m_values [ slot ];
+	}
+
+	uint8_t Count () const
+	{
+		return m_count;
+	}
+
+	// Iteration in slot order: pass GetIterator() to GetNext() until it returns 0.0.0.0.
+	uint8_t GetIterator () const
+	{
+		m_ulOperations++;
+		return 0;
+	}
+
+	// As GetIterator() but not counted, for observers such as the status screen whose
+	// reads should not show up in the operation count.
+	uint8_t GetUncountedIterator () const
+	{
+		return 0;
+	}
+
+	IPAddress GetNext ( uint8_t& iterator ) const
+	{
+		while ( iterator < SIZE )
+		{
+			uint32_t key = m_keys [ iterator++ ];
+			if ( key != 0UL )
+			{
+				return IPAddress ( key );
+			}
+		}
+		return IPAddress ( 0UL );
+	}
+
+	// Add(), Unpin(), Expire() and GetIterator() calls since boot, for the status screen.
+	uint32_t GetOperationCount () const
+	{
+		return m_ulOperations;
+	}
+
+	// Entries dropped by Expire() since boot.
+	uint32_t GetExpiredCount () const
+	{
+		return m_ulExpired;
+	}
+
+private:
+	uint32_t m_keys [ SIZE ] = {};        // address as a 32-bit value, 0 = free slot
+	uint32_t m_lastSeenMs [ SIZE ] = {};  // millis() of the last Add() for the address
+	bool m_pinned [ SIZE ] = {};          // never expired or evicted
+	T m_values [ SIZE ] = {};
+	uint8_t m_count = 0;
+	mutable uint32_t m_ulOperations = 0UL;
+	uint32_t m_ulExpired = 0UL;
+
+	// Fibonacci hash: the top bits of the product depend on every byte of the address.
+	static uint8_t Home ( uint32_t key )
+	{
+		return (uint8_t)( ( key * 2654435761UL ) >> 24 ) & ( SIZE - 1 );
+	}
+
+	int16_t FindSlot ( uint32_t key ) const
+	{
+		if ( key == 0UL )
+		{
+			return -1;
+		}
+		uint8_t slot = Home ( key );
+		for ( uint8_t probes = 0; probes < SIZE && m_keys [ slot ] != 0UL; probes++ )
+		{
+			if ( m_keys [ slot ] == key )
+			{
+				return slot;
+			}
+			slot = ( slot + 1 ) & ( SIZE - 1 );
+		}
+		return -1;
+	}
+
+	bool EvictOldest ( uint32_t nowMs )
+	{
+		int16_t victim = -1;
+		uint32_t oldestAgeMs = 0UL;
+		for ( uint8_t slot = 0; slot < SIZE; slot++ )
+		{
+			if ( m_keys [ slot ] == 0UL || m_pinned [ slot ] )
+			{
+				continue;
+			}
+			if ( victim < 0 || nowMs - m_lastSeenMs [ slot ] > oldestAgeMs )
+			{
+				victim = slot;
+				oldestAgeMs = nowMs - m_lastSeenMs [ slot ];
+			}
+		}
+		if ( victim < 0 )
+		{
+			return false;
+		}
+		RemoveAt ( (uint8_t)victim );
+		return true;
+	}
+
+	// Frees a slot, then moves back any later entry of the probe run that could no longer be
+	// found past the gap (its home slot lies at or before the hole).
+	void RemoveAt ( uint8_t slot )
+	{
+		m_keys [ slot ] = 0UL;
+		m_count--;
+		uint8_t hole = slot;
+		uint8_t next = ( slot + 1 ) & ( SIZE - 1 );
+		while ( m_keys [ next ] != 0UL )
+		{
+			uint8_t home = Home ( m_keys [ next ] );
+			if ( ( ( next - home ) & ( SIZE - 1 ) ) >= ( ( next - hole ) & ( SIZE - 1 ) ) )
+			{
+				m_keys [ hole ] = m_keys [ next ];
+				m_lastSeenMs [ hole ] = m_lastSeenMs [ next ];
+				m_pinned [ hole ] = m_pinned [ next ];
+				m_values [ hole ] = m_values [ next ];
+				m_keys [ next ] = 0UL;
+				hole = next;
+			}
+			next = ( next + 1 ) & ( SIZE - 1 );
+		}
+	}
+};
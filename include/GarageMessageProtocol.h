@@ -10,8 +10,13 @@
  *
  * History:
  *   Ver 1.0   Phase 6 — initial implementation
+ *   Ver 1.1   BuildResponse writes into a caller buffer with fixed-point formatting
+ *   Ver 1.2   Versioned payload cache for TEMPDATA and DOORDATA
+ *   Ver 1.3   DOORDATA rendered from one IGarageDoor::GetSnapshot()
+ *   Ver 1.4   STATS reply with the loop profile
  */
 
+#include "config.h"
 #include "IEnvironmentSensor.h"
 #include "IGarageDoor.h"
 #include "IMessageProtocol.h"
@@ -31,17 +36,41 @@ public:
 	                        EnvironmentReading& reading,
 	                        UDPWiFiService& service );
 
-	// Returns the UDP payload string for the given message type,
-	// or "" if no response is required (command-only messages).
-	String BuildResponse ( uint8_t msgType ) override;
+	// Writes the UDP payload for the given message type into pBuffer and returns its
+	// length, or 0 if no response is required (command-only messages).
+	size_t BuildResponse ( uint8_t msgType, char* pBuffer, size_t bufferSize ) override;
 
 	// Executes any side-effect for the given command (open door, light on, etc.).
 	// No-op for data-request message types (TEMPDATA, DOORDATA).
 	void HandleCommand ( uint8_t msgType ) override;
 
+	// Payload cache statistics.
+	uint32_t GetCacheHits () const;
+	uint32_t GetCacheMisses () const;
+
 private:
+	// Pre-rendered payload up to and including "A="; the timestamp is appended per send.
+	struct CachedPayload
+	{
+		char body [ UDP_RESPONSE_MAX_LEN ];
+		uint8_t length = 0;
+		uint32_t stateVersion = 0;  // bumped when the source data changes
+		uint32_t version = 0;       // stateVersion the body was rendered from
+		bool bValid = false;
+	};
+
 	IGarageDoor* m_pDoor;
 	IEnvironmentSensor* m_pSensor;
 	EnvironmentReading& m_reading;
 	UDPWiFiService& m_service;
+
+	CachedPayload m_cache [ 2 ];  // indexed by ReqMsgType TEMPDATA / DOORDATA
+	IGarageDoor::DoorSnapshot m_doorSnapshot = {};  // last door snapshot; DOORDATA is rendered from it
+	float m_lastReadingValues [ 4 ] = {};  // T, H, D, P the TEMPDATA body was versioned against
+	uint32_t m_ulCacheHits = 0UL;
+	uint32_t m_ulCacheMisses = 0UL;
+
+	uint32_t RefreshStateVersion ( uint8_t msgType );
+	bool RenderBody ( uint8_t msgType, CachedPayload& cache );
+	size_t BuildStatsResponse ( char* pBuffer, size_t bufferSize );
 };
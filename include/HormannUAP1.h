@@ -15,10 +15,14 @@
  * History:
  *   Ver 1.0   Initial version (as DoorState)
  *   Ver 2.0   Phase 4 — refactored from DoorState, now implements IGarageDoor
+ *   Ver 2.1   GetSnapshot(); Direction moved to IGarageDoor
+ *   Ver 2.2   Pin events queued by the ISR and dispatched from Update()
+ *   Ver 2.3   Event queue counters exposed through IGarageDoor::GetEventQueueStats()
  */
 
 #include "IGarageDoor.h"
 #include "InputPin.h"
+#include "IsrEventQueue.h"
 #include "OutputPin.h"
 
 #include <memory>
@@ -41,6 +45,7 @@ constexpr uint8_t DOOR_STATIONARY_FLASHTIME = 0;
 constexpr uint8_t DOOR_MOVING_FLASHTIME = 10;  // 20 = 1 sec
 constexpr PinStatus RELAY_ON_VALUE = HIGH;
 constexpr PinStatus RELAY_OFF = LOW;
+constexpr uint8_t DOOR_EVENT_QUEUE_SIZE = 16;  // pin events buffered between the ISR and Update()
 
 // ─── Forward declarations of internal helper classes ─────────────────────────
 class DoorStatusPin;
@@ -52,13 +57,9 @@ class DoorStatusCalc;
 class HormannUAP1 : public IGarageDoor
 {
 public:
+	using Direction = IGarageDoor::Direction;
+
 	// Additional enums specific to the Hormann UAP 1 hardware
-	enum class Direction : uint8_t
-	{
-		Up = 0,
-		Down,
-		None
-	};
 	enum class Event : uint8_t
 	{
 		DoorOpenTrue = 0,
@@ -91,6 +92,8 @@ public:
 	bool IsMoving () const override;
 	bool IsLit () const override;
 	const char* GetStateDisplayString () const override;
+	IGarageDoor::DoorSnapshot GetSnapshot () const override;
+	IGarageDoor::EventQueueStats GetEventQueueStats () const override;
 	void Open () override;
 	void Close () override;
 	void Stop () override;
@@ -99,7 +102,7 @@ public:
 	void SetStateChangedCallback ( StateChangedCallback cb ) override;
 
 	// ── Called by DoorStatusPin ISR handler — must be public ─────────────────
-	void DoEvent ( Event eEvent );
+	void QueueEvent ( Event eEvent );
 
 	// ── Diagnostics / display helpers (Hormann-specific, not in interface) ────
 	uint32_t GetLightOnCount () const;
@@ -150,8 +153,11 @@ private:
 	volatile bool m_bDoorStateChanged = true;
 	volatile uint32_t m_ulSwitchPressedTime = 0UL;
 	StateChangedCallback m_stateChangedCallback = nullptr;
+	IsrEventQueue<Event, DOOR_EVENT_QUEUE_SIZE> m_events;  // filled by QueueEvent(), drained by Update()
+	uint32_t m_ulMaxEventLatencyUs = 0UL;                  // worst ISR-to-dispatch delay seen by Update()
 
 	// ── Internal helpers ──────────────────────────────────────────────────────
+	void DoEvent ( Event eEvent );
 	void SetStateAndDirection ( IGarageDoor::State state, Direction direction );
 	void SetDoorState ( IGarageDoor::State newState );
 	void SetDoorDirection ( Direction direction );
@@ -257,10 +263,12 @@ public:
 	void SetDoorDirection ( HormannUAP1::Direction direction );
 	const char* GetDoorDirectionName () const;
 	void SetStopped ();
+	uint32_t GetChangeCount () const;
 
 private:
 	DoorStatusPin& m_openPin;
 	DoorStatusPin& m_closePin;
 	volatile IGarageDoor::State m_currentState;
+	volatile uint32_t m_ulChangeCount = 0UL;  // state changes, for DoorSnapshot::sequence
 	volatile HormannUAP1::Direction m_LastDirection = HormannUAP1::Direction::None;
 };
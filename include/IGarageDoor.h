@@ -9,6 +9,8 @@
  *
  * History:
  *   Ver 1.0   Phase 3 — interface definition only
+ *   Ver 1.1   Direction and GetSnapshot() for a coherent single-call view
+ *   Ver 1.2   GetEventQueueStats()
  */
 
 #include <stdint.h>
@@ -32,6 +34,48 @@ public:
 		Off,
 		Unknown
 	};
+	enum class Direction : uint8_t
+	{
+		Up = 0,
+		Down,
+		None
+	};
+
+	// Everything a consumer needs about the door, captured in one critical section so the
+	// fields agree with each other even if a status-pin ISR fires part way through.
+	struct DoorSnapshot
+	{
+		State state;
+		bool bLit;
+		Direction direction;
+		const char* stateName;   // same text as GetStateDisplayString()
+		uint32_t openedCount;    // times the door reached fully open
+		uint32_t closedCount;    // times the door reached fully closed
+		uint32_t lightOnCount;   // light status pin on transitions
+		uint32_t lightOffCount;  // light status pin off transitions
+		uint32_t sequence;       // advances on every state or light change
+
+		bool IsOpen () const
+		{
+			return state == State::Open;
+		}
+		bool IsClosed () const
+		{
+			return state == State::Closed;
+		}
+		bool IsMoving () const
+		{
+			return state == State::Opening || state == State::Closing;
+		}
+	};
+	// Health of the queue between the status-pin ISRs and Update(): if Update() is not called
+	// often enough events wait longer and, once the queue is full, are dropped.
+	struct EventQueueStats
+	{
+		uint32_t overflowCount;  // events dropped because the queue was full
+		uint8_t peak;            // most events waiting at once
+		uint32_t maxLatencyUs;   // longest wait between an ISR queueing an event and Update()
+	};
 	using StateChangedCallback = void ( * ) ( State newState );
 
 	virtual ~IGarageDoor () = default;
@@ -50,6 +94,8 @@ public:
 	virtual bool IsMoving () const = 0;
 	virtual bool IsLit () const = 0;
 	virtual const char* GetStateDisplayString () const = 0;
+	virtual DoorSnapshot GetSnapshot () const = 0;
+	virtual EventQueueStats GetEventQueueStats () const = 0;
 
 	// Commands
 	virtual void Open () = 0;
@@ -9,6 +9,7 @@
  *
  * History:
  *   Ver 1.0   Phase 3 — interface definition only
+ *   Ver 1.1   BuildResponse writes into a caller buffer instead of returning a String
  */
 
 #include <Arduino.h>
@@ -18,9 +19,9 @@ class IMessageProtocol
 public:
 	virtual ~IMessageProtocol () = default;
 
-	// Returns the UDP payload string for a given message type,
-	// or "" if no response needed
-	virtual String BuildResponse ( uint8_t msgType ) = 0;
+	// Writes the null-terminated UDP payload for a given message type into pBuffer
+	// and returns its length, or 0 if no response needed (or it did not fit)
+	virtual size_t BuildResponse ( uint8_t msgType, char* pBuffer, size_t bufferSize ) = 0;
 
 	// Executes any side-effect for a command (open door, light on, etc.)
 	virtual void HandleCommand ( uint8_t msgType ) = 0;
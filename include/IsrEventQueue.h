@@ -0,0 +1,98 @@
+#pragma once
+/*
+ * IsrEventQueue.h
+ *
+ * Lock-free single-producer / single-consumer ring for handing events from an
+ * interrupt handler to the main loop.  The ISR side is Push(): it stores the
+ * event with a micros() timestamp and publishes it by advancing the tail; it
+ * never allocates, logs or blocks.  The loop side is Pop(), which advances the
+ * head.  Each index is written by exactly one side, so no critical section is
+ * needed on a single-core Cortex-M0+; the signal fences only stop the compiler
+ * reordering the entry copy around the index update.
+ *
+ * All pin interrupts on the SAMD21 share the one EIC handler and cannot
+ * pre-empt each other, so several pins may push into the same queue and still
+ * count as a single producer.
+ *
+ * When the ring is full the new event is discarded and counted; the consumer
+ * is expected to keep up, so an overflow is a diagnostic, not a normal case.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+#include <atomic>
+#include <stdint.h>
+
+template <typename T, uint8_t SIZE>
+class IsrEventQueue
+{
+	static_assert ( SIZE >= 2 && SIZE <= 128 && ( SIZE & ( SIZE - 1 ) ) == 0, "SIZE must be a power of two up to 128" );
+
+public:
+	struct Entry
+	{
+		T event;
+		uint32_t timestampUs;  // micros() when the ISR queued the event
+	};
+
+	// ISR side: queues an event; returns false (and counts an overflow) if the ring is full.
+	bool Push ( T event )
+	{
+		uint8_t tail = m_tail;
+		uint8_t used = (uint8_t)( tail - m_head );
+		if ( used >= SIZE )
+		{
+			m_ulOverflows++;
+			return false;
+		}
+		Entry& entry = m_entries [ tail & ( SIZE - 1 ) ];
+		entry.event = event;
+		entry.timestampUs = micros();
+		std::atomic_signal_fence ( std::memory_order_release );
+		m_tail = (uint8_t)( tail + 1 );
+		if ( used + 1 > m_highWaterMark )
+		{
+			m_highWaterMark = used + 1;
+		}
+		return true;
+	}
+
+	// Loop side: removes the oldest event into entry; returns false when empty.
+	bool Pop ( Entry& entry )
+	{
+		uint8_t head = m_head;
+		if ( head == m_tail )
+		{
+			return false;
+		}
+		std::atomic_signal_fence ( std::memory_order_acquire );
+		entry = m_entries [ head & ( SIZE - 1 ) ];
+		std::atomic_signal_fence ( std::memory_order_release );
+		m_head = (uint8_t)( head + 1 );
+		return true;
+	}
+
+	uint8_t Count () const
+	{
+		return (uint8_t)( m_tail - m_head );
+	}
+	uint8_t GetHighWaterMark () const
+	{
+		return m_highWaterMark;
+	}
+	uint32_t GetOverflowCount () const
+	{
+		return m_ulOverflows;
+	}
+
+private:
+	Entry m_entries [ SIZE ];
+	volatile uint8_t m_head = 0;  // next entry to pop; written only by the loop
+	volatile uint8_t m_tail = 0;  // next free entry; written only by the ISR
+	volatile uint8_t m_highWaterMark = 0;
+	volatile uint32_t m_ulOverflows = 0UL;
+};
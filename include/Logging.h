@@ -16,10 +16,20 @@ When outputting the Log commands repace Serial.print(ln) output
 There are also functions to send ANSI escape sequences to allow output in colour and at specific screen locations
 The serial monitor needs to be able to support these ANSI sequences. A free example is PuTTY.
 
+ansiVT220Logger keeps a shadow copy of the 132x25 screen (character and colours per cell) and only sends the
+cells that differ from it, so a status screen that is redrawn in full every frame costs only what changed.
+Clears are applied at EndFrame() to whatever was not redrawn since, so clear-then-rewrite of an unchanged value
+sends nothing.
+
 Author: (c) M. Naylor 2022
 
 History:
     Ver 1.0			Initial version
+    Ver 1.1			Shadow-buffer diff rendering and per-frame byte count
+    Ver 1.2			CTelnet transmit buffer
+    Ver 1.3			Telnet clients accepted by a rate-limited Poll() rather than on every write
+    Ver 1.4			Client connection state and backlog visible through Logger and ansiVT220Logger
+    Ver 1.5			CTelnet drops a client that stops taking data
 */
 
 
@@ -34,6 +44,18 @@ public:
 	virtual void LogStart () = 0;
 	virtual bool CanDetectClientConnect () = 0;
 	virtual void SetConnectCallback ( voidFuncPtrParam ){};
+	// Looks for a client to connect; call regularly from the loop.
+	virtual void Poll (){};
+	// Whether anyone can see the output; transports that cannot tell report true.
+	virtual bool IsClientConnected ()
+	{
+		return true;
+	}
+	// Bytes written but not yet taken by the client.
+	virtual size_t GetPendingBytes ()
+	{
+		return 0;
+	}
 
 private:
 };
@@ -55,6 +77,9 @@ public:
     Telnet
     This class is used to allow an incoming telnet connection. It only outputs and does not process incoming data
     It does require an active (connected) network WiFi session
+    Output is collected in a transmit buffer and sent when it fills or flush() is called
+    New clients are only accepted by Poll(), at most every TELNET_ACCEPT_POLL_MS; without a client, output is discarded
+    A client whose backlog has not shrunk for TELNET_STALL_TIMEOUT_MS is dropped so Poll() can accept another
 */
 class CTelnet : public Logger
 {
@@ -64,7 +89,13 @@ public:
 	void LogStart ();
 	bool CanDetectClientConnect ();
 	void SetConnectCallback ( voidFuncPtrParam pConnectCallback ) override;
+	void Poll () override;
+	bool IsClientConnected () override;
+	size_t GetPendingBytes () override;
 	int available ();
+	void flush () override;
+	uint32_t GetFlushCount () const;
+	uint32_t GetAverageFlushBytes () const;
 
 private:
 	// char			   buff [ 32 ];
@@ -73,6 +104,7 @@ private:
 	size_t write ( uint8_t c );
 	size_t write ( const uint8_t* buffer, size_t size );
 	void DoConnect ();
+	void Accept ();
 	int read ();
 	int peek ();
 
@@ -81,11 +113,17 @@ private:
 	uint16_t m_telnetPort;
 	bool m_bClientConnected = false;
 	voidFuncPtrParam m_ConnectCallback = nullptr;
+	uint32_t m_ulLastAcceptMs = 0UL;
+	uint32_t m_ulLastProgressMs = 0UL;  // millis() when the backlog was last empty or shrank
+	uint8_t m_txBuffer [ TELNET_TX_BUFFER_SIZE ];  // output waiting for flush()
+	size_t m_txLen = 0;
+	uint32_t m_ulFlushes = 0UL;
+	uint32_t m_ulFlushedBytes = 0UL;
 };
 
 extern CTelnet Telnet;
 
-/// @brief This class sends VT220 sequences to the supplied logger
+/// @brief This class sends VT220 sequences to the supplied logger, only for cells that have changed
 class ansiVT220Logger
 {
 public:
@@ -129,7 +167,7 @@ public:
 
 	const static uint8_t MAX_COLS = 132;
 	const static uint8_t MAX_ROWS = 25;
-	ansiVT220Logger ( Logger& logger ) : m_logger ( logger ) {};
+	ansiVT220Logger ( Logger& logger );
 	void ClearScreen ();
 	void AT ( uint8_t row, uint8_t col, String s );
 	void COLOUR_AT ( colours FGColour, colours BGColour, uint8_t row, uint8_t col, String s );
@@ -137,15 +175,49 @@ public:
 	void SaveCursor ( void );
 	void ClearLine ( uint8_t row );
 	void ClearPartofLine ( uint8_t row, uint8_t start_col, uint8_t toclear );
+	void EndFrame ();
+	void Poll ();
+	bool IsClientConnected ();
+	bool ReadyForFrame ();
+	uint32_t GetLastFrameBytes () const;
+	uint32_t GetMaxFrameBytes () const;
 	static void OnClientConnect ( void* ptr );
 	void LogStart ();
 
 private:
+	// Cell attribute: foreground colour index in the high nibble, background in the low
+	// (0-7 normal, 8-15 bright). Black on black stands for the terminal's default colours.
+	const static uint8_t ATTR_DEFAULT = 0x00;
+	const static uint8_t ATTR_UNKNOWN = 0xFF;  // terminal colours not known
+	const static uint8_t CURSOR_UNKNOWN = 0xFF;
+	const static uint8_t MAX_REWRITE_GAP = 6;  // unchanged cells re-sent rather than moving the cursor past them
+
 	Logger& m_logger;
-	const String CSI = F ( "\x1b[" );
+	// What the terminal shows, 0-based [row][col], and the cells cleared since the last frame
+	// that nothing has been written to yet.
+	char m_shadowChars [ MAX_ROWS ][ MAX_COLS ];
+	uint8_t m_shadowAttrs [ MAX_ROWS ][ MAX_COLS ];
+	uint8_t m_pendingClear [ MAX_ROWS ][ ( MAX_COLS + 7 ) / 8 ];
+	uint8_t m_cursorRow = CURSOR_UNKNOWN;
+	uint8_t m_cursorCol = CURSOR_UNKNOWN;
+	uint8_t m_currentAttr = ATTR_UNKNOWN;
+	bool m_bRepaint = false;
+	uint32_t m_ulFrameBytes = 0UL;
+	uint32_t m_ulLastFrameBytes = 0UL;
+	uint32_t m_ulMaxFrameBytes = 0UL;
+
+	void WriteCells ( uint8_t row, uint8_t col, const char* pText, uint8_t len, uint8_t attr );
+	void MoveTo ( uint8_t row, uint8_t col );
+	void SetAttr ( uint8_t attr );
+	void Emit ( const char* pData, size_t len );
+	void Emit ( const String& s );
+	void ResetShadow ();
+	void RepaintIfNeeded ();
+	static uint8_t MakeAttr ( colours FGColour, colours BGColour );
+
+	static ansiVT220Logger* ms_pScreen;  // instance whose transport has the connect callback
 	const String SAVE_CURSOR = F ( "\x1b[s" );
 	const String RESTORE_CURSOR = F ( "\x1b[u" );
-	const String CLEAR_LINE = F ( "\x1b[2K" );
 	const String RESET_COLOURS = F ( "\x1b[0m" );
 	const String CLEAR_SCREEN = F ( "\x1b[2J" );
 	static String OSC;
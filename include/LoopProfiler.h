@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * LoopProfiler.h
+ *
+ * Times each stage of Application::loop() (see LoopStages.h) and the whole
+ * pass with micros(), keeping per-slot log2 histograms from which the maximum
+ * and percentiles are reported.  Bucket 0 counts times of 0–1 us, bucket k
+ * counts [2^k, 2^(k+1)) us and the last bucket everything from 2^15 us (~33 ms)
+ * up, so a percentile is reported as the top of its bucket, capped at the
+ * observed maximum: an upper bound within a factor of two.
+ *
+ * Counts are 16 bits; when a bucket fills, every bucket of that slot is halved,
+ * which keeps the shape of the distribution and slowly ages out old passes.
+ * The whole profiler is about 300 bytes of RAM and is only compiled when
+ * LOOP_PROFILER is defined.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "LoopStages.h"
+
+#include <stdint.h>
+
+#ifdef LOOP_PROFILER
+
+class LoopProfiler
+{
+public:
+	static constexpr uint8_t PASS_SLOT = (uint8_t)LoopStage::Count;  // slot timing the whole pass
+	static constexpr uint8_t SLOT_COUNT = PASS_SLOT + 1;
+	static constexpr uint8_t BUCKET_COUNT = 16;
+
+	// Called through the LoopStages.h markers.
+	void StageBegin ( LoopStage stage );
+	void PassEnd ();
+
+	// Largest time recorded for a slot since the last Reset(), in us.
+	uint32_t GetMaxUs ( uint8_t slot ) const;
+	// Upper bound of the given percentile (1–100) for a slot, in us; 0 if nothing recorded.
+	uint32_t GetPercentileUs ( uint8_t slot, uint8_t percent ) const;
+	uint32_t GetPassCount () const;
+	void Reset ();
+
+	// Short display name for a slot ("led" ... "sendq", "pass").
+	static const char* SlotName ( uint8_t slot );
+
+private:
+	uint16_t m_histogram [ SLOT_COUNT ][ BUCKET_COUNT ] = {};
+	uint32_t m_maxUs [ SLOT_COUNT ] = {};
+	uint32_t m_ulPasses = 0UL;
+	uint32_t m_ulPassStartUs = 0UL;
+	uint32_t m_ulStageStartUs = 0UL;
+	int8_t m_stage = -1;  // stage being timed, -1 between passes
+
+	void Record ( uint8_t slot, uint32_t us );
+};
+
+extern LoopProfiler theLoopProfiler;
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+/*
+ * LoopStages.h
+ *
+ * Markers for the stages of one Application::loop() pass.  The loop calls
+ * LoopStageBegin() as it enters each stage and LoopPassEnd() when the pass is
+ * complete; whoever implements the markers can then time every stage.
+ *
+ * The markers are implemented in LoopProfiler.cpp when LOOP_PROFILER (the
+ * on-board profiler) or LOOP_TRACE (the env:native harness timeline, through
+ * LoopTraceStage() / LoopTracePassEnd()) is defined; otherwise they are empty
+ * inline functions and compile away.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   Markers shared by LoopProfiler and the native timeline
+ */
+
+#include <stdint.h>
+
+enum class LoopStage : uint8_t
+{
+	Led = 0,     // status LED update
+	Onboarding,  // onboarding portal (AP mode only)
+	Udp,         // inbound UDP drain and replies
+	Sensor,      // BME280 read and multicast
+	Display,     // debug screen refresh
+	Door,        // door state machine and change multicast
+	SendQueue,   // outbound multicast queue
+	Count
+};
+
+#ifdef LOOP_TRACE
+// Implemented by the env:native harness.
+void LoopTraceStage ( LoopStage stage );
+void LoopTracePassEnd ();
+#endif
+
+#if defined( LOOP_PROFILER ) || defined( LOOP_TRACE )
+void LoopStageBegin ( LoopStage stage );
+void LoopPassEnd ();
+#else
+inline void LoopStageBegin ( LoopStage )
+{
+}
+inline void LoopPassEnd ()
+{
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+/*
+ * OutboundPacketQueue.h
+ *
+ * Fixed-capacity FIFO of outbound UDP datagrams.  UDPWiFiService::SendAll()
+ * fans a message out into one entry per destination and returns immediately;
+ * UDPWiFiService::ProcessSendQueue() drains a bounded number of entries per
+ * loop pass, so a broadcast never holds up door or sensor handling.
+ *
+ * Storage is a static ring (no heap).  When the queue is full the oldest
+ * entry is discarded to make room — the newest door / sensor state is always
+ * the one worth delivering — and the drop is counted.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "config.h"
+
+#include <WiFiNINA.h>
+
+class OutboundPacketQueue
+{
+public:
+	struct Packet
+	{
+		IPAddress dest;
+		uint16_t port;
+		uint8_t length;
+		char payload [ SEND_QUEUE_MAX_PAYLOAD ];
+	};
+
+	// Copies the payload into the queue; returns false only if it is too long to hold.
+	bool Push ( IPAddress dest, uint16_t port, const char* payload, size_t length );
+
+	// Oldest queued packet, or nullptr when empty.  Valid until the next Pop() / Push().
+	const Packet* Peek () const;
+	void Pop ();
+
+	bool IsEmpty () const;
+	uint8_t Count () const;
+	uint8_t GetHighWaterMark () const;
+	uint32_t GetDroppedCount () const;
+
+private:
+	Packet m_packets [ SEND_QUEUE_DEPTH ];
+	uint8_t m_head = 0;   // index of the oldest entry
+	uint8_t m_count = 0;  // entries in use
+	uint8_t m_highWaterMark = 0;
+	uint32_t m_ulDropped = 0UL;
+};
@@ -0,0 +1,104 @@
+#pragma once
+/*
+ * Scheduler.h
+ *
+ * Small fixed-capacity cooperative scheduler driving Application::loop().
+ * Each task has a period (0 = run on every pass), a priority (lower runs
+ * first), a deadline (how late a run may start before it counts as missed)
+ * and a run-time budget (a longer run counts as an overrun).  RunDue() runs
+ * every due task once, in priority order.
+ *
+ * Nothing is pre-empted, so a slow task still delays the ones after it.  What
+ * the scheduler guarantees is that every-pass tasks (UDP, door) run on every
+ * pass ahead of the periodic ones, and that once a pass has used
+ * SCHEDULER_PASS_BUDGET_US the periodic tasks still due wait for the next
+ * pass rather than piling up behind each other — so a display frame and a
+ * sensor read falling due together are split by a UDP poll.
+ *
+ * Between passes Idle() can put the CPU to sleep with __WFI() until the next
+ * interrupt: the 1 ms SysTick, a door pin edge or any other peripheral IRQ.
+ * The SysTick bounds each sleep, so every-pass tasks are still polled at least
+ * once a millisecond; the awake / asleep split is measured for the status
+ * screen.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   Idle() sleep with duty-cycle measurement
+ */
+
+#include "config.h"
+#include "LoopStages.h"
+
+#include <stdint.h>
+
+class Scheduler
+{
+public:
+	typedef void ( *TaskFunction ) ();
+
+	// Per-task statistics since boot.
+	struct TaskStats
+	{
+		const char* name;
+		uint32_t runs;
+		uint32_t maxRunUs;   // longest single run
+		uint32_t maxLateUs;  // worst start delay past the due time (for every-pass tasks: gap between runs)
+		uint32_t missed;     // runs that started later than the deadline
+		uint32_t overruns;   // runs longer than the budget
+		uint32_t deferrals;  // passes the task was due but held back by the pass budget
+	};
+
+	// Registers a task, first due on the next RunDue(). The stage is passed to the
+	// LoopStages.h markers around each run. Returns false when the table is full.
+	bool AddTask ( const char* name,
+	               TaskFunction function,
+	               LoopStage stage,
+	               uint32_t periodMs,
+	               uint8_t priority,
+	               uint32_t deadlineMs,
+	               uint32_t budgetUs );
+
+	// Runs every due task once, highest priority first; call from loop().
+	void RunDue ();
+
+	// Sleeps until the next interrupt unless a periodic task is already due; call
+	// after RunDue() when the pass found nothing to do.
+	void Idle ();
+
+	uint8_t GetTaskCount () const;
+	TaskStats GetTaskStats ( uint8_t index ) const;
+
+	// Duty cycle: share of the last complete IDLE_STATS_WINDOW_MS spent awake, in
+	// tenths of a percent (1000 = never slept), and totals since boot.
+	uint16_t GetAwakePermille () const;
+	uint32_t GetSleepCount () const;
+	uint32_t GetTotalSleepMs () const;
+
+private:
+	struct Task
+	{
+		const char* name;
+		TaskFunction function;
+		uint32_t periodUs;
+		uint32_t deadlineUs;
+		uint32_t budgetUs;
+		uint32_t nextDueUs;
+		uint8_t priority;
+		LoopStage stage;
+		TaskStats stats;
+	};
+
+	Task m_tasks [ SCHEDULER_MAX_TASKS ];  // kept sorted by priority
+	uint8_t m_taskCount = 0;
+
+	uint32_t m_ulWindowStartUs = 0UL;
+	uint32_t m_ulWindowSleepUs = 0UL;
+	uint32_t m_ulSleepRemainderUs = 0UL;  // sub-millisecond part not yet added to m_ulTotalSleepMs
+	uint32_t m_ulTotalSleepMs = 0UL;
+	uint32_t m_ulSleeps = 0UL;
+	uint16_t m_awakePermille = 1000;
+
+	void UpdateDutyCycle ( uint32_t nowUs );
+};
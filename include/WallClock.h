@@ -0,0 +1,63 @@
+#pragma once
+/*
+ * WallClock.h
+ *
+ * UTC wall clock derived from millis().  The epoch is fetched from the NINA
+ * module (NTP) only occasionally via Sync(); between syncs the time is the
+ * last synced epoch plus elapsed millis(), corrected by an estimated drift, so
+ * reading the time costs no SPI traffic and has millisecond resolution.
+ *
+ * Drift is estimated over the whole span since the first sync, which keeps
+ * the 1 s resolution of the NTP epoch from swamping the estimate.  The resync
+ * interval adapts: it doubles (up to CLOCK_RESYNC_MAX_MS) while syncs need
+ * only small corrections and halves (down to CLOCK_RESYNC_MIN_MS) when they
+ * don't.
+ *
+ * Elapsed time is kept in a 64-bit counter so the clock is unaffected by the
+ * 49-day millis() wrap, provided Tick() is called at least once per wrap.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "config.h"
+
+#include <Arduino.h>
+
+class WallClock
+{
+public:
+	// Folds elapsed millis() into the 64-bit counter; call regularly (every loop pass).
+	void Tick ();
+
+	bool IsSyncDue () const;
+	void Sync ( uint32_t epochSecs );
+	void SyncFailed ();
+
+	bool IsSynced () const;
+	uint32_t GetEpoch () const;    // seconds since 1970 UTC, 0 until synced
+	uint64_t GetEpochMs () const;  // milliseconds since 1970 UTC, 0 until synced
+
+	int32_t GetDriftPpm () const;
+	int32_t GetLastCorrectionMs () const;
+	uint32_t GetSyncCount () const;
+	uint32_t GetResyncIntervalMs () const;
+
+private:
+	uint64_t NowMonoMs () const;
+
+	uint64_t m_ullMonoMs = 0ULL;       // extended millis() as of the last Tick()
+	uint32_t m_ulLastMillis = 0UL;     // millis() at the last Tick()
+	bool m_bSynced = false;
+	uint64_t m_ullSyncEpochMs = 0ULL;  // epoch at the last sync
+	uint64_t m_ullSyncMonoMs = 0ULL;   // extended millis() at the last sync
+	uint64_t m_ullBaseEpochMs = 0ULL;  // epoch at the start of the drift baseline
+	uint64_t m_ullBaseMonoMs = 0ULL;   // extended millis() at the start of the drift baseline
+	uint64_t m_ullNextSyncMonoMs = 0ULL;
+	uint32_t m_ulResyncIntervalMs = CLOCK_RESYNC_MIN_MS;
+	int32_t m_driftPpm = 0;            // positive when millis() runs slow
+	int32_t m_lastCorrectionMs = 0;    // true minus predicted time at the last sync
+	uint32_t m_ulSyncCount = 0UL;
+};
@@ -10,11 +10,19 @@ Author: (c) M. Naylor 2022
 History:
     Ver 1.0			Initial version
     Ver 2.0			Added onboarding support with BlobStorage
+    Ver 2.1			Network-info snapshot refreshed on connection events
+    Ver 2.2			Cached connection flag
+    Ver 2.3			Local subnet registered once per connection; list operation rate
+    Ver 2.4			Multicast destinations held in a FixedIPSet with lease expiry
+    Ver 2.5			CIDR broadcast addresses from the subnet mask
+    Ver 2.6			Per-destination send health with skip/backoff
 */
 #include "ConfigStorage.h"
-#include "FixedIPList.h"
+#include "FixedIPSet.h"
 #include "Logging.h"
 #include "OnboardingServer.h"
+#include "OutboundPacketQueue.h"
+#include "WallClock.h"
 
 #include <MNRGBLEDBaseLib.h>
 #include <OnboardingPortal.h>
@@ -38,6 +46,29 @@ public:
 		AP_MODE
 	};
 
+	// Connection state machine, advanced one step per loop by ServiceConnection()
+	enum class LinkState : uint8_t
+	{
+		IDLE,        // no station connection wanted (AP mode, not configured or stopped)
+		WAITING,     // disconnected; next attempt due at m_nextReconnectMs
+		CONNECTING,  // WiFi.begin() issued, polling for WL_CONNECTED
+		CONNECTED,   // associated with the access point
+		COUNT
+	};
+
+	// Network details read from the NINA module when a connection is made (or AP
+	// mode starts), so the display and logs need no SPI round trips to show them.
+	struct NetworkInfo
+	{
+		char ssid [ 33 ];  // empty until the first connection
+		IPAddress localIP;
+		IPAddress subnetMask;
+		IPAddress gatewayIP;
+		uint8_t mac [ 6 ];  // as from WiFi.macAddress(): last byte first
+		int32_t rssi;       // dBm, re-sampled every RSSI_SAMPLE_MS while connected
+		uint8_t status;     // last WiFi.status() seen by the connection state machine
+	};
+
 	WiFiService ();
 	~WiFiService ();
 	void Begin ( const char* apSSID, const char* apPassword, MNRGBLEDBaseLib* pLED = nullptr );
@@ -50,19 +81,35 @@ public:
 	Status GetState () const;
 	static String ToIPString ( const IPAddress& address );
 	unsigned long GetTime () const;
+	uint64_t GetTimeMs () const;
+	const WallClock& GetClock () const;
 	float GetAltitudeCompensation () const;
 	uint32_t GetBeginCount ();
 	uint32_t GetBeginTimeOutCount () const;
 	bool IsConnected () const;
+	bool IsLinkUp () const;
+	LinkState GetLinkState () const;
+	uint32_t GetTimeInLinkState () const;
+	uint32_t GetTotalTimeInLinkState ( LinkState state ) const;
+	static const char* LinkStateToString ( LinkState state );
 	const char* WiFiStatusToString ( uint8_t iState ) const;
+	const NetworkInfo& GetNetworkInfo () const;
 
 protected:
 	void WiFiDisconnect ();
 	bool WiFiConnect ();
+	void ServiceConnection ();
+	void ServiceClock ();
+	virtual void OnConnected ();
+	void SetLinkState ( LinkState state );
 	void SetLED ( RGBType theColour, uint8_t flashTime = 0 );
+	void PulseLED ( RGBType theColour, uint32_t durationMs );
+	void ServiceLED ();
 	void SetState ( WiFiService::Status state );
 	void CalcMyMulticastAddress ( IPAddress& result ) const;
 	void CalcMulticastAddress ( IPAddress ip, IPAddress& result ) const;
+	static IPAddress PrefixToSubnetMask ( uint8_t prefixLen );
+	static IPAddress BroadcastAddress ( IPAddress ip, IPAddress mask );
 	void StartAP ();
 	void LoadAndConnectFromStorage ();
 
@@ -83,8 +130,26 @@ private:
 	const char* m_apPassword = nullptr;
 	Status m_State = Status::UNCONNECTED;
 	IPAddress m_multicastAddr = 0UL;
-	bool m_isConnected = false;
+	bool m_isConnected = false;  // station link up, as last seen; read by IsConnected()
 	MNRGBLEDBaseLib* m_pLED = nullptr;
+	bool m_bLEDPulseActive = false;        // activity colour showing, state colour restored on expiry
+	uint32_t m_ulLEDPulseStartMs = 0UL;
+	uint32_t m_ulLEDPulseDurationMs = 0UL;
+	WallClock m_clock;
+	LinkState m_linkState = LinkState::IDLE;
+	uint32_t m_ulLinkStateSinceMs = 0UL;  // millis() when m_linkState was entered
+	uint32_t m_ulLinkStateTotalMs [ static_cast<uint8_t> ( LinkState::COUNT ) ] = {};
+	uint32_t m_ulConnectStartMs = 0UL;    // millis() when the current WiFi.begin() was issued
+	uint32_t m_ulLastStatusPollMs = 0UL;  // millis() of the last WiFi.status() poll while CONNECTING
+	uint32_t m_ulLastLinkCheckMs = 0UL;   // millis() of the last WiFi.status() check while CONNECTED
+	NetworkInfo m_netInfo = {};
+	uint32_t m_ulLastRssiSampleMs = 0UL;  // millis() of the last WiFi.RSSI() sample
+
+	void ShowStateLED ();
+	void StartConnectAttempt ();
+	void ConnectAttemptSucceeded ();
+	void ConnectAttemptFailed ( uint8_t status );
+	void RefreshNetworkInfo ();
 };
 
 class UDPWiFiService : public WiFiService
@@ -98,12 +163,35 @@ public:
 		DOORCLOSE,
 		DOORSTOP,
 		LIGHTON,
-		LIGHTOFF
+		LIGHTOFF,
+		STATS
 	};
 
 	typedef void ( *UDPWiFiServiceCallback ) ( UDPWiFiService::ReqMsgType uiParam );
 
-	UDPWiFiService ();
+	// DecodeV1Request() results other than a ReqMsgType value.
+	static constexpr uint8_t DECODE_RESTART = 0xFE;  // M002, handled by ProcessUDPMessage() itself
+	static constexpr uint8_t DECODE_UNKNOWN = 0xFF;  // not a recognised code
+
+	// Decodes the message code of a "V001:" request without allocating; public for the
+	// env:native decode benchmark (GC_BENCH_DECODE).
+	static uint8_t DecodeV1Request ( const char* pMsg, size_t len, bool& bVersionOK );
+
+	// Send health of one multicast destination, kept with it in the destination set.
+	struct DestHealth
+	{
+		uint32_t sent;                // datagrams handed to the NINA
+		uint32_t failed;              // beginPacket() / endPacket() failures
+		uint32_t skipped;             // sends held back by a skip window
+		uint32_t lastFailMs;          // millis() of the last failure
+		uint32_t skipMs;              // no sends for this long after lastFailMs; 0 = sending
+		uint32_t lastSendMs;          // millis() of the last send attempt, for pacing
+		uint32_t lastSendUs;          // beginPacket() to endPacket() for the last send
+		uint32_t maxSendUs;           // worst beginPacket() to endPacket() since added
+		uint8_t consecutiveFailures;  // failures since the last success
+	};
+	typedef FixedIPSet<MULTICAST_DEST_SLOTS, DestHealth> MulticastDestSet;
+
 	bool Begin ( UDPWiFiServiceCallback pHandleReqData,
 	             const char* apSSID,
 	             const char* apPassword,
@@ -112,12 +200,22 @@ public:
 	void ProcessOnboarding ();
 	// void		 DisplayStatus ( ansiVT220Logger logger );
 	void GetLocalTime ( String& result, time_t timeError = 0 );
-	FixedIPList* GetMulticastList ();
+	const MulticastDestSet& GetMulticastList () const;
 	uint32_t GetMCastSentCount ();
 	uint32_t GetRequestsReceivedCount ();
 	uint32_t GetReplySentCount ();
-	bool SendAll ( String sMsg );
-	bool SendReply ( String sMsg );
+	uint32_t GetLastReplyLatencyUs () const;
+	uint32_t GetMaxReplyLatencyUs () const;
+	uint8_t GetLastDrainCount () const;
+	uint8_t GetMaxDrainCount () const;
+	uint32_t GetDrainLimitReachedCount () const;
+	uint32_t GetDrainBudgetExhaustedCount () const;
+	uint32_t GetDestListOpsPerMinute () const;
+	uint32_t GetDestEscalationCount () const;
+	bool SendAll ( const char* pMsg, size_t len );
+	void ProcessSendQueue ();
+	const OutboundPacketQueue& GetSendQueue () const;
+	bool SendReply ( const char* pMsg, size_t len );
 	bool Start ();
 	void Stop ();
 
@@ -130,17 +228,38 @@ private:
 
 	uint16_t m_Port = 0;
 	WiFiUDP m_myUDP;
-	String m_sUDPReceivedMsg;
+	char m_sRecvBuffer [ UDP_MAX_REQUEST_LEN ];  // last request read by ReadUDPMessage()
 	UDPWiFiServiceCallback m_MsgHandlerCallback;
-	FixedIPList* m_pMulticastDestList = nullptr;
+	MulticastDestSet m_multicastDests;  // subnet broadcast addresses SendAll() sends to
+	IPAddress m_pinnedDest;             // local subnet pinned by the last Start()
 	uint32_t m_ulBadRequests = 0UL;
 	uint32_t m_ulBadMgsVersion = 0UL;
 	uint32_t m_ulReqCount = 0UL;
 	uint32_t m_ulMCastSentCount = 0UL;
 	uint32_t m_ulReplyCount = 0UL;
+	uint32_t m_ulRequestRxMicros = 0UL;       // micros() when the request being handled was read
+	bool m_bReplyPending = false;             // request read but not yet answered
+	uint32_t m_ulLastReplyLatencyUs = 0UL;    // parsePacket() to SendReply() for the last request
+	uint32_t m_ulMaxReplyLatencyUs = 0UL;     // worst parsePacket() to SendReply() since boot
+	uint8_t m_lastDrained = 0;                // packets taken by the last CheckUDP(), discarded ones included
+	uint8_t m_maxDrained = 0;                 // most packets taken by one CheckUDP()
+	uint32_t m_ulDrainLimitReached = 0UL;     // CheckUDP() calls that hit UDP_DRAIN_MAX_PACKETS
+	uint32_t m_ulDrainBudgetExhausted = 0UL;  // CheckUDP() calls cut short by UDP_DRAIN_BUDGET_US
 	WiFiState m_WiFiState = WiFiState::DISCONNECTED;
+	OutboundPacketQueue m_sendQueue;       // multicasts waiting for ProcessSendQueue()
+	uint32_t m_ulDestListWindowMs = 0UL;   // millis() at the start of the list operations window
+	uint32_t m_ulDestListWindowOps = 0UL;  // list operation count at the start of the window
+	uint32_t m_ulDestListOpsPerMin = 0UL;  // list operations in the last complete window
+	uint32_t m_ulDestEscalations = 0UL;    // multicast failures passed on to link recovery
 
-	bool GetUDPMessage ( String& RecvMessage );
-	void ProcessUDPMessage ( const String& sRecvMessage );
-	bool ReadUDPMessage ( String& sRecvMessage );
+	void OnConnected () override;
+	void UpdateDestListStats ();
+	bool IsDestSkipped ( IPAddress dest );
+	bool IsDestPaced ( IPAddress dest ) const;
+	void RecordDestSend ( IPAddress dest, bool bSent, uint32_t sendUs );
+	bool AllDestsFailing () const;
+	void ResetDestBackoff ();
+	bool GetUDPMessage ( size_t& len, bool& bValid );
+	void ProcessUDPMessage ( const char* pRecvMessage, size_t len );
+	bool ReadUDPMessage ( size_t& len, bool& bValid );
 };
\ No newline at end of file
@@ -37,18 +37,63 @@ constexpr pin_size_t TURN_LIGHT_ON_OUTPUT_PIN = 2;
 // ─── Serial / Telnet ──────────────────────────────────────────────────────────
 constexpr uint32_t BAUD_RATE = 115200;
 constexpr uint16_t TELNET_PORT = 0xFEEE;
+constexpr size_t TELNET_TX_BUFFER_SIZE = 1460;         // Telnet output per send: one TCP segment (1500-byte MTU)
+constexpr uint32_t TELNET_ACCEPT_POLL_MS = 1000;       // interval between checks for a new Telnet client
+constexpr uint32_t TELNET_STALL_TIMEOUT_MS = 10000UL;  // drop a Telnet client that has taken nothing for this long
 
 // ─── WiFi ─────────────────────────────────────────────────────────────────────
 constexpr uint32_t WIFI_CONNECT_TIMEOUT_MS = 10000;
+constexpr uint32_t WIFI_CONNECT_POLL_MS = 500;       // WiFi.status() poll interval while an attempt is in progress
+constexpr uint32_t LINK_CHECK_INTERVAL_MS = 1000UL;  // WiFi.status() check interval while connected
+constexpr uint32_t RSSI_SAMPLE_MS = 30000UL;         // WiFi.RSSI() sample interval while connected
 
 // ─── WiFi reconnection backoff ────────────────────────────────────────────────
 constexpr uint32_t WIFI_RECONNECT_BASE_DELAY_MS = 5000UL;  // 5 s initial backoff
 constexpr uint32_t WIFI_RECONNECT_MAX_DELAY_MS = 60000UL;  // 60 s maximum backoff
 constexpr uint8_t WIFI_RECONNECT_MAX_ATTEMPTS = 10;        // reset after this many consecutive failures
 
+// ─── UDP service ──────────────────────────────────────────────────────────────
+constexpr uint32_t PROCESSING_LED_PULSE_MS = 500;  // how long the LED shows a request being handled
+constexpr uint8_t SEND_QUEUE_DEPTH = 8;            // outbound datagrams held for the send stage
+constexpr uint8_t SEND_QUEUE_MAX_PAYLOAD = 96;     // largest queued message (TEMPDATA is ~50 bytes)
+constexpr uint8_t SEND_QUEUE_MAX_PER_PASS = 2;     // datagrams sent per ProcessSendQueue() call
+constexpr uint32_t SEND_QUEUE_PACING_MS = 20;      // minimum gap between datagrams to one destination
+// multicast payload buffer: the largest queued message and its null
+constexpr size_t UDP_RESPONSE_MAX_LEN = SEND_QUEUE_MAX_PAYLOAD + 1;
+constexpr size_t UDP_REPLY_MAX_LEN = 256;          // unicast reply buffer; replies are not queued so may be longer
+constexpr size_t UDP_MAX_REQUEST_LEN = 255;        // receive buffer; longer requests are discarded
+constexpr uint8_t UDP_DRAIN_MAX_PACKETS = 4;       // requests handled per CheckUDP() call
+constexpr uint32_t UDP_DRAIN_BUDGET_US = 20000UL;  // stop draining once a CheckUDP() call has used this long
+
+// ─── Multicast destinations ───────────────────────────────────────────────────
+constexpr uint8_t MULTICAST_DEST_SLOTS = 4;              // subnets multicasts are sent to; a power of two
+constexpr uint32_t MULTICAST_DEST_LEASE_MS = 3600000UL;  // drop a subnet after an hour with no request from it
+constexpr uint32_t DEST_LIST_STATS_MS = 60000UL;         // window for the destination set operations-per-minute figure
+constexpr uint8_t REMOTE_SUBNET_PREFIX_LEN = 24;         // assumed prefix of a requester's subnet off the local one
+constexpr uint32_t DEST_BACKOFF_BASE_MS = 5000UL;        // skip window after a destination's first failed send
+constexpr uint32_t DEST_BACKOFF_MAX_MS = 300000UL;       // skip window cap; it doubles with each further failure
+
+// ─── Wall clock (NTP via NINA) ────────────────────────────────────────────────
+constexpr uint32_t CLOCK_SYNC_RETRY_MS = 10000UL;                // retry interval while NTP time is unavailable
+constexpr uint32_t CLOCK_RESYNC_MIN_MS = 15UL * 60UL * 1000UL;   // shortest interval between resyncs
+constexpr uint32_t CLOCK_RESYNC_MAX_MS = 6UL * 3600UL * 1000UL;  // longest interval between resyncs
+constexpr uint32_t CLOCK_MAX_CORRECTION_MS = 1500UL;             // larger corrections shorten the resync interval
+constexpr uint32_t CLOCK_DRIFT_MIN_BASELINE_MS = 3600000UL;      // span needed before drift is estimated
+constexpr int32_t CLOCK_MAX_DRIFT_PPM = 1000;                    // beyond this the time source is assumed to have stepped
+
 // ─── Sensor polling ───────────────────────────────────────────────────────────
 constexpr uint32_t SENSOR_READ_INTERVAL_MS = 30000;
 
+// ─── Loop scheduler ───────────────────────────────────────────────────────────
+constexpr uint8_t SCHEDULER_MAX_TASKS = 8;              // fixed task table size
+constexpr uint32_t SCHEDULER_PASS_BUDGET_US = 10000UL;  // periodic tasks due after this much of a pass wait for the next
+constexpr uint32_t DISPLAY_REFRESH_MS = 500;            // debug screen refresh period
+constexpr uint32_t POLL_TASK_DEADLINE_MS = 50;          // longest acceptable gap between runs of an every-pass task
+constexpr uint32_t POLL_TASK_BUDGET_US = 2000UL;        // expected longest run of the LED, door and send-queue tasks
+constexpr uint32_t SENSOR_TASK_BUDGET_US = 10000UL;     // BME280 read and multicast
+constexpr uint32_t DISPLAY_TASK_BUDGET_US = 20000UL;    // one debug screen frame
+constexpr uint32_t IDLE_STATS_WINDOW_MS = 1000;         // duty-cycle measurement window
+
 // ─── Humidity LED thresholds ──────────────────────────────────────────────────
 constexpr float HUMIDITY_MAX = 60.0f;
 constexpr float HUMIDITY_MIN = 40.0f;
@@ -0,0 +1,312 @@
+/*
+ * Arduino.cpp (native stand-in)
+ *
+ * Host implementations of the Arduino timing, interrupt, digital I/O and
+ * Print/Serial primitives.  millis()/micros() come from CLOCK_MONOTONIC, or
+ * from the harness's virtual clock when a simulation is running.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   Virtual clock for simulation runs
+ *   Ver 1.2   __WFI() sleeps to the next millisecond tick
+ */
+
+#include "Arduino.h"
+
+#include "NativeHarness.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+HardwareSerialStandIn Serial;
+
+// ─── Time ─────────────────────────────────────────────────────────────────────
+
+// In simulation the clock is virtual: it runs at real speed while a loop()
+// pass executes, so stage timings stay honest, but the harness moves it
+// straight on to the next deadline between passes and delay() never sleeps.
+
+static bool s_bVirtualClock = false;
+static uint64_t s_virtualBaseUs = 0;  // virtual time at s_realMarkUs
+static uint64_t s_realMarkUs = 0;
+
+static uint64_t realMicros ()
+{
+	static uint64_t s_startUs = 0;
+	timespec ts;
+	clock_gettime ( CLOCK_MONOTONIC, &ts );
+	uint64_t nowUs = (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+	if ( s_startUs == 0 )
+	{
+		s_startUs = nowUs;
+	}
+	return nowUs - s_startUs;
+}
+
+static uint64_t monotonicMicros ()
+{
+	uint64_t realUs = realMicros();
+	return s_bVirtualClock ? s_virtualBaseUs + ( realUs - s_realMarkUs ) : realUs;
+}
+
+namespace NativeHarness
+{
+void StartVirtualClock ( uint64_t startUs )
+{
+	s_realMarkUs = realMicros();
+	s_virtualBaseUs = startUs;
+	s_bVirtualClock = true;
+}
+
+bool IsVirtualClock ()
+{
+	return s_bVirtualClock;
+}
+
+uint64_t ClockMicros ()
+{
+	return monotonicMicros();
+}
+
+void AdvanceClockTo ( uint64_t us )
+{
+	uint64_t nowUs = monotonicMicros();
+	s_realMarkUs = realMicros();
+	s_virtualBaseUs = us > nowUs ? us : nowUs;
+}
+}  // namespace NativeHarness
+
+unsigned long millis ()
+{
+	return (uint32_t)( monotonicMicros() / 1000ULL );
+}
+
+unsigned long micros ()
+{
+	return (uint32_t)monotonicMicros();
+}
+
+void delay ( unsigned long ms )
+{
+	if ( s_bVirtualClock )
+	{
+		NativeHarness::RunUntil ( monotonicMicros() + ms * 1000ULL );
+		return;
+	}
+	// Keep timers and scripted pin events flowing while the sketch blocks,
+	// as the SysTick / EIC interrupts would on the board.
+	uint32_t start = millis();
+	while ( millis() - start < ms )
+	{
+		NativeHarness::Poll();
+		usleep ( 1000 );
+	}
+}
+
+void delayMicroseconds ( unsigned int us )
+{
+	if ( s_bVirtualClock )
+	{
+		NativeHarness::AdvanceClockTo ( monotonicMicros() + us );
+		return;
+	}
+	usleep ( us );
+}
+
+// ─── Interrupt control ───────────────────────────────────────────────────────
+
+void noInterrupts ()
+{
+	NativeHarness::SetInterruptsEnabled ( false );
+}
+
+void interrupts ()
+{
+	NativeHarness::SetInterruptsEnabled ( true );
+}
+
+uint32_t __get_PRIMASK ()
+{
+	return NativeHarness::InterruptsEnabled() ? 0U : 1U;
+}
+
+void __set_PRIMASK ( uint32_t priMask )
+{
+	NativeHarness::SetInterruptsEnabled ( ( priMask & 1U ) == 0 );
+}
+
+void __disable_irq ()
+{
+	noInterrupts();
+}
+
+void __enable_irq ()
+{
+	interrupts();
+}
+
+void __WFI ()
+{
+	uint64_t nowUs = monotonicMicros();
+	uint64_t tickUs = nowUs - nowUs % 1000ULL + 1000ULL;
+	if ( s_bVirtualClock )
+	{
+		NativeHarness::RunUntil ( tickUs );
+		return;
+	}
+	usleep ( (useconds_t)( tickUs - nowUs ) );
+	NativeHarness::Poll();
+}
+
+void NVIC_SystemReset ()
+{
+	NativeHarness::Restart();
+}
+
+// ─── Digital I/O ──────────────────────────────────────────────────────────────
+
+static PinStatus s_pinLevel [ 256 ] = {};
+
+void pinMode ( pin_size_t, PinMode )
+{
+}
+
+void digitalWrite ( pin_size_t pin, PinStatus val )
+{
+	s_pinLevel [ pin ] = val;
+}
+
+PinStatus digitalRead ( pin_size_t pin )
+{
+	return s_pinLevel [ pin ];
+}
+
+void analogWrite ( pin_size_t, int )
+{
+}
+
+// ─── Print ────────────────────────────────────────────────────────────────────
+
+size_t Print::write ( const uint8_t* buffer, size_t size )
+{
+	size_t n = 0;
+	while ( size-- )
+	{
+		if ( write ( *buffer++ ) )
+		{
+			n++;
+		}
+		else
+		{
+			break;
+		}
+	}
+	return n;
+}
+
+size_t Print::write ( const char* str )
+{
+	return str == nullptr ? 0 : write ( (const uint8_t*)str, strlen ( str ) );
+}
+
+size_t Print::print ( const String& s )
+{
+	return write ( (const uint8_t*)s.c_str(), s.length() );
+}
+
+size_t Print::print ( const char* s )
+{
+	return write ( s );
+}
+
+size_t Print::print ( const __FlashStringHelper* s )
+{
+	return write ( (const char*)s );
+}
+
+size_t Print::print ( char c )
+{
+	return write ( (uint8_t)c );
+}
+
+size_t Print::print ( unsigned char n )
+{
+	return print ( String ( n ) );
+}
+
+size_t Print::print ( int n )
+{
+	return print ( String ( n ) );
+}
+
+size_t Print::print ( unsigned int n )
+{
+	return print ( String ( n ) );
+}
+
+size_t Print::print ( long n )
+{
+	return print ( String ( n ) );
+}
+
+size_t Print::print ( unsigned long n )
+{
+	return print ( String ( n ) );
+}
+
+size_t Print::print ( double n, int digits )
+{
+	return print ( String ( n, (unsigned char)digits ) );
+}
+
+// ─── Serial (stdout / stdin) ──────────────────────────────────────────────────
+
+void HardwareSerialStandIn::begin ( unsigned long )
+{
+	int flags = fcntl ( STDIN_FILENO, F_GETFL, 0 );
+	if ( flags >= 0 )
+	{
+		fcntl ( STDIN_FILENO, F_SETFL, flags | O_NONBLOCK );
+	}
+}
+
+void HardwareSerialStandIn::end ()
+{
+}
+
+HardwareSerialStandIn::operator bool ()
+{
+	return true;
+}
+
+int HardwareSerialStandIn::available ()
+{
+	pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+	return poll ( &pfd, 1, 0 ) > 0 ? 1 : 0;
+}
+
+int HardwareSerialStandIn::read ()
+{
+	unsigned char c;
+	return ::read ( STDIN_FILENO, &c, 1 ) == 1 ? c : -1;
+}
+
+int HardwareSerialStandIn::peek ()
+{
+	return -1;
+}
+
+size_t HardwareSerialStandIn::write ( uint8_t c )
+{
+	return fwrite ( &c, 1, 1, stdout );
+}
+
+size_t HardwareSerialStandIn::write ( const uint8_t* buffer, size_t size )
+{
+	size_t n = fwrite ( buffer, 1, size, stdout );
+	fflush ( stdout );
+	return n;
+}
@@ -0,0 +1,109 @@
+#pragma once
+/*
+ * Arduino.h (native stand-in)
+ *
+ * Minimal subset of the ArduinoCore-API used by GarageControl, implemented on
+ * top of POSIX so that the real application sources build and run on Linux
+ * under the PlatformIO env:native target.  Only what the project actually uses
+ * is provided; this is not a general purpose Arduino emulation.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   __WFI()
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+
+typedef uint8_t byte;
+typedef uint8_t pin_size_t;
+typedef void ( *voidFuncPtr ) ( void );
+typedef void ( *voidFuncPtrParam ) ( void* );
+
+enum PinStatus
+{
+	LOW = 0,
+	HIGH = 1,
+	CHANGE = 2,
+	FALLING = 3,
+	RISING = 4
+};
+
+enum PinMode
+{
+	INPUT = 0x0,
+	OUTPUT = 0x1,
+	INPUT_PULLUP = 0x2,
+	INPUT_PULLDOWN = 0x3
+};
+
+// MKR WiFi 1010 analogue pin numbering
+constexpr pin_size_t PIN_A0 = 15;
+constexpr pin_size_t PIN_A1 = 16;
+constexpr pin_size_t PIN_A2 = 17;
+constexpr pin_size_t PIN_A3 = 18;
+constexpr pin_size_t PIN_A4 = 19;
+constexpr pin_size_t PIN_A5 = 20;
+constexpr pin_size_t PIN_A6 = 21;
+
+#ifndef NOT_A_PIN
+#define NOT_A_PIN 255
+#endif
+
+using std::max;
+using std::min;
+
+// ─── Time ─────────────────────────────────────────────────────────────────────
+unsigned long millis ();
+unsigned long micros ();
+void delay ( unsigned long ms );
+void delayMicroseconds ( unsigned int us );
+
+// ─── Interrupt control (single threaded host — bookkeeping only) ───────────
+void noInterrupts ();
+void interrupts ();
+// CMSIS PRIMASK intrinsics; bit 0 set means interrupts are disabled
+uint32_t __get_PRIMASK ();
+void __set_PRIMASK ( uint32_t priMask );
+void __disable_irq ();
+void __enable_irq ();
+// Sleeps until the next 1 ms SysTick boundary, as WFI in the board's idle loop would.
+void __WFI ();
+void NVIC_SystemReset ();
+
+// ─── Digital I/O ──────────────────────────────────────────────────────────────
+void pinMode ( pin_size_t pin, PinMode mode );
+void digitalWrite ( pin_size_t pin, PinStatus val );
+PinStatus digitalRead ( pin_size_t pin );
+void analogWrite ( pin_size_t pin, int val );
+
+#include "Stream.h"
+#include "WString.h"
+
+class HardwareSerialStandIn : public Stream
+{
+public:
+	void begin ( unsigned long baud );
+	void end ();
+	operator bool ();
+	int available () override;
+	int read () override;
+	int peek () override;
+	size_t write ( uint8_t c ) override;
+	size_t write ( const uint8_t* buffer, size_t size ) override;
+	using Print::write;
+};
+
+extern HardwareSerialStandIn Serial;
+
+// Sketch entry points supplied by the application (main.cpp)
+void setup ();
+void loop ();
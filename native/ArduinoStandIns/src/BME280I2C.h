@@ -0,0 +1,121 @@
+#pragma once
+/*
+ * BME280I2C.h (native stand-in)
+ *
+ * Simulated BME280 exposing the subset of the finitespace/BME280 API used by
+ * BME280Sensor.  Readings drift slowly around typical garage conditions so
+ * change-driven code paths see realistic values.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class BME280
+{
+public:
+	enum OSR
+	{
+		OSR_Off,
+		OSR_X1,
+		OSR_X2,
+		OSR_X4,
+		OSR_X8,
+		OSR_X16
+	};
+	enum Mode
+	{
+		Mode_Sleep,
+		Mode_Forced,
+		Mode_Normal
+	};
+	enum StandbyTime
+	{
+		StandbyTime_500us,
+		StandbyTime_62500us,
+		StandbyTime_125ms,
+		StandbyTime_250ms,
+		StandbyTime_50ms,
+		StandbyTime_1000ms,
+		StandbyTime_10ms,
+		StandbyTime_20ms
+	};
+	enum Filter
+	{
+		Filter_Off,
+		Filter_2,
+		Filter_4,
+		Filter_8,
+		Filter_16
+	};
+	enum SpiEnable
+	{
+		SpiEnable_False,
+		SpiEnable_True
+	};
+	enum ChipModel
+	{
+		ChipModel_Unknown = 0,
+		ChipModel_BMP280 = 0x58,
+		ChipModel_BME280 = 0x60
+	};
+	enum TempUnit
+	{
+		TempUnit_Celsius,
+		TempUnit_Fahrenheit
+	};
+	enum PresUnit
+	{
+		PresUnit_Pa,
+		PresUnit_hPa
+	};
+
+	ChipModel chipModel ()
+	{
+		return ChipModel_BME280;
+	}
+
+	void read ( float& pressure, float& temp, float& humidity, TempUnit = TempUnit_Celsius, PresUnit = PresUnit_hPa )
+	{
+		float phase = (float)( millis() % 3600000UL ) / 3600000.0f * 6.2831853f;
+		temp = 15.0f + 3.0f * sinf ( phase );
+		humidity = 60.0f + 10.0f * cosf ( phase );
+		pressure = 1000.0f + 5.0f * sinf ( phase / 2.0f );
+	}
+};
+
+class BME280I2C : public BME280
+{
+public:
+	enum I2CAddr
+	{
+		I2CAddr_0x76 = 0x76,
+		I2CAddr_0x77 = 0x77
+	};
+
+	struct Settings
+	{
+		Settings ( OSR = OSR_X1,
+		           OSR = OSR_X1,
+		           OSR = OSR_X1,
+		           Mode = Mode_Forced,
+		           StandbyTime = StandbyTime_1000ms,
+		           Filter = Filter_Off,
+		           SpiEnable = SpiEnable_False,
+		           I2CAddr = I2CAddr_0x76 )
+		{
+		}
+	};
+
+	explicit BME280I2C ( const Settings& = Settings() )
+	{
+	}
+
+	bool begin ()
+	{
+		return true;
+	}
+};
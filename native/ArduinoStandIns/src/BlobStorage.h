@@ -0,0 +1,102 @@
+#pragma once
+/*
+ * BlobStorage.h (native stand-in)
+ *
+ * File backed implementation of the BlobStorage interface.  The blob lives in
+ * the file named by GC_CONFIG_FILE (default ./<name>.blob) so configuration
+ * survives an emulated reset exactly as flash does on the board.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class BlobStorage
+{
+public:
+	enum Error
+	{
+		SUCCESS = 0,
+		ERROR_NOT_INITIALIZED,
+		ERROR_NOT_FOUND,
+		ERROR_SIZE_MISMATCH,
+		ERROR_IO
+	};
+
+	BlobStorage ( const char* name, size_t size ) : m_size ( size )
+	{
+		const char* path = getenv ( "GC_CONFIG_FILE" );
+		if ( path != nullptr && *path != '\0' )
+		{
+			snprintf ( m_path, sizeof ( m_path ), "%s", path );
+		}
+		else
+		{
+			snprintf ( m_path, sizeof ( m_path ), "./%s.blob", name );
+		}
+	}
+
+	Error begin ()
+	{
+		m_bReady = true;
+		return SUCCESS;
+	}
+
+	Error read ( void* data, size_t size )
+	{
+		if ( !m_bReady )
+		{
+			return ERROR_NOT_INITIALIZED;
+		}
+		if ( size != m_size )
+		{
+			return ERROR_SIZE_MISMATCH;
+		}
+		FILE* f = fopen ( m_path, "rb" );
+		if ( f == nullptr )
+		{
+			return ERROR_NOT_FOUND;
+		}
+		size_t n = fread ( data, 1, size, f );
+		fclose ( f );
+		return n == size ? SUCCESS : ERROR_NOT_FOUND;
+	}
+
+	Error write ( const void* data, size_t size )
+	{
+		if ( !m_bReady )
+		{
+			return ERROR_NOT_INITIALIZED;
+		}
+		if ( size != m_size )
+		{
+			return ERROR_SIZE_MISMATCH;
+		}
+		FILE* f = fopen ( m_path, "wb" );
+		if ( f == nullptr )
+		{
+			return ERROR_IO;
+		}
+		size_t n = fwrite ( data, 1, size, f );
+		fclose ( f );
+		return n == size ? SUCCESS : ERROR_IO;
+	}
+
+	Error clear ()
+	{
+		if ( !m_bReady )
+		{
+			return ERROR_NOT_INITIALIZED;
+		}
+		remove ( m_path );
+		return SUCCESS;
+	}
+
+private:
+	size_t m_size;
+	bool m_bReady = false;
+	char m_path [ 256 ];
+};
@@ -0,0 +1,22 @@
+#pragma once
+/*
+ * BlobStorageFactory.h (native stand-in)
+ *
+ * Always selects the file backed BlobStorage on the host.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "BlobStorage.h"
+
+class BlobStorageFactory
+{
+public:
+	static BlobStorage* create ( const char* name, size_t size )
+	{
+		return new BlobStorage ( name, size );
+	}
+};
@@ -0,0 +1,143 @@
+/*
+ * DecodeBenchmark.cpp (native stand-in)
+ *
+ * Host microbenchmark of V001 request decoding, run by the env:native program
+ * instead of the sketch when GC_BENCH_DECODE is set (see NativeHarness.h).
+ * For each message code it times the old decoder, a chain of
+ * substring().startsWith() tests that built a String per test, against
+ * UDPWiFiService::DecodeV1Request(), and checks that both give the same
+ * answer.  The old chain is reproduced here as it was in WiFiService.cpp,
+ * with the M009 (STATS) test appended where it would have gone.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "NativeHarness.h"
+
+#include "WiFiService.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+namespace
+{
+constexpr char cMsgVersion1 [] = "V001";
+constexpr char PartSeparator [] = ":";
+constexpr size_t MSG_CODE_OFFSET = sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2;
+
+// Codes in the order the old chain tested them, with what each decodes to.
+struct LegacyCode
+{
+	const char* code;
+	uint8_t decoded;
+};
+const LegacyCode LEGACY_CHAIN [] = { { "M001", UDPWiFiService::ReqMsgType::TEMPDATA },
+                                     { "M002", UDPWiFiService::DECODE_RESTART },
+                                     { "M003", UDPWiFiService::ReqMsgType::DOORDATA },
+                                     { "M004", UDPWiFiService::ReqMsgType::DOOROPEN },
+                                     { "M005", UDPWiFiService::ReqMsgType::DOORCLOSE },
+                                     { "M006", UDPWiFiService::ReqMsgType::DOORSTOP },
+                                     { "M007", UDPWiFiService::ReqMsgType::LIGHTON },
+                                     { "M008", UDPWiFiService::ReqMsgType::LIGHTOFF },
+                                     { "M009", UDPWiFiService::ReqMsgType::STATS } };
+
+// Messages timed: every code, an unknown code and a wrong version.
+const char* const MESSAGES [] = { "V001:M001", "V001:M002", "V001:M003", "V001:M004", "V001:M005", "V001:M006",
+                                  "V001:M007", "V001:M008", "V001:M009", "V001:M099", "V002:M001" };
+
+volatile uint8_t s_sink;  // keeps the timed calls from being optimised away
+
+/**
+ * @brief The decoder as it was before the table: one substring() and startsWith() per code.
+ * @param sMsg Message as received.
+ * @return A ReqMsgType value, DECODE_RESTART or DECODE_UNKNOWN; bVersionOK as DecodeV1Request().
+ */
+uint8_t LegacyDecode ( const String& sMsg, bool& bVersionOK )
+{
+	bVersionOK = sMsg.startsWith ( cMsgVersion1 );
+	if ( !bVersionOK )
+	{
+		return UDPWiFiService::DECODE_UNKNOWN;
+	}
+	for ( const LegacyCode& entry : LEGACY_CHAIN )
+	{
+		if ( sMsg.substring ( MSG_CODE_OFFSET ).startsWith ( entry.code ) )
+		{
+			return entry.decoded;
+		}
+	}
+	return UDPWiFiService::DECODE_UNKNOWN;
+}
+
+uint64_t NowNs ()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds> (
+	           std::chrono::steady_clock::now().time_since_epoch() )
+	    .count();
+}
+}  // namespace
+
+namespace NativeHarness
+{
+/**
+ * @brief Times both decoders on every message and prints nanoseconds per decode.
+ * @details GC_BENCH_ITERATIONS sets the decodes per message and decoder (default 200000).
+ *          The String is built once per message outside the timed loop, as the old
+ *          receive path built it before decoding.
+ * @return Process exit status: 0, or 1 if the decoders disagree on any message.
+ */
+int RunDecodeBenchmark ()
+{
+	const char* pIterations = getenv ( "GC_BENCH_ITERATIONS" );
+	uint32_t iterations = pIterations != nullptr ? (uint32_t)strtoul ( pIterations, nullptr, 10 ) : 200000UL;
+	if ( iterations == 0 )
+	{
+		iterations = 1;
+	}
+	int status = 0;
+	printf ( "%-10s %8s %12s %12s %8s\n", "message", "decoded", "chain ns", "table ns", "speedup" );
+	for ( const char* pMsg : MESSAGES )
+	{
+		size_t len = strlen ( pMsg );
+		String sMsg ( pMsg );
+		bool bLegacyVersionOK;
+		bool bVersionOK;
+		uint8_t legacy = LegacyDecode ( sMsg, bLegacyVersionOK );
+		uint8_t decoded = UDPWiFiService::DecodeV1Request ( pMsg, len, bVersionOK );
+		if ( legacy != decoded || bLegacyVersionOK != bVersionOK )
+		{
+			printf ( "%-10s MISMATCH chain %u table %u\n", pMsg, legacy, decoded );
+			status = 1;
+			continue;
+		}
+
+		uint64_t startNs = NowNs();
+		for ( uint32_t i = 0; i < iterations; i++ )
+		{
+			s_sink = LegacyDecode ( sMsg, bLegacyVersionOK );
+		}
+		double chainNs = (double)( NowNs() - startNs ) / iterations;
+
+		startNs = NowNs();
+		for ( uint32_t i = 0; i < iterations; i++ )
+		{
+			s_sink = UDPWiFiService::DecodeV1Request ( pMsg, len, bVersionOK );
+		}
+		double tableNs = (double)( NowNs() - startNs ) / iterations;
+
+		printf ( "%-10s %8u %12.1f %12.1f %7.0fx\n",
+		         pMsg,
+		         decoded,
+		         chainNs,
+		         tableNs,
+		         tableNs > 0.0 ? chainNs / tableNs : 0.0 );
+	}
+	return status;
+}
+}  // namespace NativeHarness
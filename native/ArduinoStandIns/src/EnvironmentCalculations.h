@@ -0,0 +1,30 @@
+#pragma once
+/*
+ * EnvironmentCalculations.h (native stand-in)
+ *
+ * The two finitespace/BME280 helpers used by BME280Sensor, using the same
+ * formulae as the library.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+namespace EnvironmentCalculations
+{
+inline float EquivalentSeaLevelPressure ( float altitude, float temp, float pres )
+{
+	return pres / powf ( 1.0f - ( ( 0.0065f * altitude ) / ( temp + ( 0.0065f * altitude ) + 273.15f ) ), 5.257f );
+}
+
+inline float DewPoint ( float temp, float hum )
+{
+	const float a = 17.62f;
+	const float b = 243.12f;
+	float gamma = logf ( hum / 100.0f ) + ( a * temp ) / ( b + temp );
+	return b * gamma / ( a - gamma );
+}
+}  // namespace EnvironmentCalculations
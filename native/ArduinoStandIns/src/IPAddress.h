@@ -0,0 +1,51 @@
+#pragma once
+/*
+ * IPAddress.h (native stand-in)
+ *
+ * IPv4 address value type.  As on the board the raw 32-bit value holds the
+ * octets in network order in memory, so ( ip & 0xff ) is the first octet.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+class IPAddress
+{
+public:
+	IPAddress () = default;
+	IPAddress ( uint32_t address ) : m_address ( address )
+	{
+	}
+	IPAddress ( uint8_t first, uint8_t second, uint8_t third, uint8_t fourth )
+	{
+		uint8_t bytes [ 4 ] = { first, second, third, fourth };
+		memcpy ( &m_address, bytes, sizeof ( m_address ) );
+	}
+
+	operator uint32_t () const
+	{
+		return m_address;
+	}
+	uint8_t operator[] ( int index ) const
+	{
+		uint8_t bytes [ 4 ];
+		memcpy ( bytes, &m_address, sizeof ( bytes ) );
+		return bytes [ index & 3 ];
+	}
+	bool operator== ( const IPAddress& rhs ) const
+	{
+		return m_address == rhs.m_address;
+	}
+	bool operator!= ( const IPAddress& rhs ) const
+	{
+		return m_address != rhs.m_address;
+	}
+
+private:
+	uint32_t m_address = 0;
+};
@@ -0,0 +1,100 @@
+/*
+ * InputPin.cpp (native stand-in)
+ *
+ * See InputPin.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "InputPin.h"
+
+#include "NativeHarness.h"
+
+InputPin::InputPin ( pin_size_t pin,
+                     uint32_t debouncems,
+                     uint32_t maxMatchedTimems,
+                     PinStatus matchStatus,
+                     PinMode mode,
+                     PinStatus )
+    : m_pin ( pin ), m_debouncems ( debouncems ), m_maxMatchedTimems ( maxMatchedTimems ), m_matchStatus ( matchStatus )
+{
+	if ( m_pin == NOT_A_PIN )
+	{
+		return;
+	}
+	pinMode ( m_pin, mode );
+	m_bMatched = GetCurrentMatchedState();
+	NativeHarness::RegisterInputPin ( this );
+}
+
+InputPin::~InputPin ()
+{
+	NativeHarness::UnregisterInputPin ( this );
+}
+
+pin_size_t InputPin::GetPin () const
+{
+	return m_pin;
+}
+
+bool InputPin::IsMatched () const
+{
+	return m_bMatched;
+}
+
+bool InputPin::GetCurrentMatchedState () const
+{
+	return m_pin != NOT_A_PIN && digitalRead ( m_pin ) == m_matchStatus;
+}
+
+uint32_t InputPin::GetMatchedCount () const
+{
+	return m_matchedCount;
+}
+
+uint32_t InputPin::GetUnmatchedCount () const
+{
+	return m_unmatchedCount;
+}
+
+void InputPin::DebugStats ( String& result ) const
+{
+	result += F ( "Pin " );
+	result += m_pin;
+	result += F ( " matched " );
+	result += m_matchedCount;
+	result += F ( " unmatched " );
+	result += m_unmatchedCount;
+	result += F ( " rejected " );
+	result += m_rejectedCount;
+}
+
+void InputPin::OnEdge ( PinStatus level )
+{
+	uint32_t now = millis();
+	bool bMatch = ( level == m_matchStatus );
+	if ( bMatch == m_bMatched )
+	{
+		return;
+	}
+	if ( m_matchedCount + m_unmatchedCount > 0 && now - m_lastEdgeMs < m_debouncems )
+	{
+		m_rejectedCount++;
+		return;
+	}
+	m_lastEdgeMs = now;
+	m_bMatched = bMatch;
+	if ( bMatch )
+	{
+		m_matchedCount++;
+		MatchAction();
+	}
+	else
+	{
+		m_unmatchedCount++;
+		UnmatchAction();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+/*
+ * InputPin.h (native stand-in)
+ *
+ * Host version of the interrupt driven, debounced digital input class.  Edges
+ * are delivered by NativeHarness::SetPin() (directly or from a pin script)
+ * instead of the SAMD21 EIC, so door sequences can be scripted on the host.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class InputPin
+{
+public:
+	InputPin ( pin_size_t pin,
+	           uint32_t debouncems,
+	           uint32_t maxMatchedTimems,
+	           PinStatus matchStatus,
+	           PinMode mode = PinMode::INPUT,
+	           PinStatus status = PinStatus::CHANGE );
+	virtual ~InputPin ();
+
+	pin_size_t GetPin () const;
+	bool IsMatched () const;
+	bool GetCurrentMatchedState () const;
+	uint32_t GetMatchedCount () const;
+	uint32_t GetUnmatchedCount () const;
+	void DebugStats ( String& result ) const;
+
+	// Called by NativeHarness in "interrupt" context when the pin level changes.
+	void OnEdge ( PinStatus level );
+
+protected:
+	virtual void MatchAction () const
+	{
+	}
+	virtual void UnmatchAction () const
+	{
+	}
+
+private:
+	const pin_size_t m_pin;
+	const uint32_t m_debouncems;
+	const uint32_t m_maxMatchedTimems;
+	const PinStatus m_matchStatus;
+	volatile bool m_bMatched = false;
+	volatile uint32_t m_matchedCount = 0UL;
+	volatile uint32_t m_unmatchedCount = 0UL;
+	volatile uint32_t m_rejectedCount = 0UL;
+	volatile uint32_t m_lastEdgeMs = 0UL;
+};
@@ -0,0 +1,14 @@
+#pragma once
+/*
+ * MNPCIHandler.h (native stand-in)
+ *
+ * Pin change interrupts are delivered by NativeHarness on the host, so this
+ * header only needs to exist for the includes to resolve.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
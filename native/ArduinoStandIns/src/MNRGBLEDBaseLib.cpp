@@ -0,0 +1,51 @@
+/*
+ * MNRGBLEDBaseLib.cpp (native stand-in)
+ *
+ * See MNRGBLEDBaseLib.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "MNRGBLEDBaseLib.h"
+
+MKRRGBLED TheMKR_RGB_LED;
+
+MNRGBLEDBaseLib::MNRGBLEDBaseLib ( const char* name ) : m_name ( name )
+{
+}
+
+void MNRGBLEDBaseLib::SetLEDColour ( RGBType colour, uint8_t flashTime )
+{
+	if ( colour != m_colour || flashTime != m_flashTime )
+	{
+		fprintf ( stderr, "[%lu] %s LED %06X flash %u\n", millis(), m_name, (unsigned)colour, (unsigned)flashTime );
+	}
+	m_colour = colour;
+	m_flashTime = flashTime;
+}
+
+RGBType MNRGBLEDBaseLib::GetLEDColour () const
+{
+	return m_colour;
+}
+
+uint8_t MNRGBLEDBaseLib::GetFlashTime () const
+{
+	return m_flashTime;
+}
+
+void MNRGBLEDBaseLib::Invert ()
+{
+	m_bInverted = !m_bInverted;
+}
+
+CRGBLED::CRGBLED ( pin_size_t, pin_size_t, pin_size_t, uint8_t, uint8_t, uint8_t ) : MNRGBLEDBaseLib ( "external" )
+{
+}
+
+MKRRGBLED::MKRRGBLED () : MNRGBLEDBaseLib ( "MKR" )
+{
+}
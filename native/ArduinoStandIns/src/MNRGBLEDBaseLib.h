@@ -0,0 +1,76 @@
+#pragma once
+/*
+ * MNRGBLEDBaseLib.h (native stand-in)
+ *
+ * Host version of the RGB LED library.  Colour changes are recorded (and
+ * reported on stderr) rather than driven onto PWM pins.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+typedef uint32_t RGBType;
+
+constexpr RGBType RGB ( uint8_t red, uint8_t green, uint8_t blue )
+{
+	return ( (RGBType)red << 16 ) | ( (RGBType)green << 8 ) | (RGBType)blue;
+}
+
+class MNRGBLEDBaseLib
+{
+public:
+	enum eColour : RGBType
+	{
+		BLACK = RGB ( 0, 0, 0 ),
+		WHITE = RGB ( 255, 255, 255 ),
+		RED = RGB ( 255, 0, 0 ),
+		GREEN = RGB ( 0, 255, 0 ),
+		BLUE = RGB ( 0, 0, 255 ),
+		YELLOW = RGB ( 255, 255, 0 ),
+		MAGENTA = RGB ( 255, 0, 255 ),
+		CYAN = RGB ( 0, 255, 255 ),
+		DARK_RED = RGB ( 128, 0, 0 ),
+		DARK_GREEN = RGB ( 0, 128, 0 ),
+		DARK_BLUE = RGB ( 0, 0, 128 ),
+		DARK_YELLOW = RGB ( 128, 128, 0 ),
+		DARK_MAGENTA = RGB ( 128, 0, 128 ),
+		DARK_CYAN = RGB ( 0, 128, 128 )
+	};
+
+	explicit MNRGBLEDBaseLib ( const char* name );
+	virtual ~MNRGBLEDBaseLib () = default;
+
+	void SetLEDColour ( RGBType colour, uint8_t flashTime = 0 );
+	RGBType GetLEDColour () const;
+	uint8_t GetFlashTime () const;
+	void Invert ();
+
+private:
+	const char* m_name;
+	RGBType m_colour = BLACK;
+	uint8_t m_flashTime = 0;
+	bool m_bInverted = false;
+};
+
+class CRGBLED : public MNRGBLEDBaseLib
+{
+public:
+	CRGBLED ( pin_size_t redPin,
+	          pin_size_t greenPin,
+	          pin_size_t bluePin,
+	          uint8_t redMax = 255,
+	          uint8_t greenMax = 255,
+	          uint8_t blueMax = 255 );
+};
+
+class MKRRGBLED : public MNRGBLEDBaseLib
+{
+public:
+	MKRRGBLED ();
+};
+
+extern MKRRGBLED TheMKR_RGB_LED;
@@ -0,0 +1,76 @@
+/*
+ * MNTimerLib.cpp (native stand-in)
+ *
+ * See MNTimerLib.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "MNTimerLib.h"
+
+MNTimerLib TheTimer;
+
+bool MNTimerLib::AddCallBack ( MNTimerClass* pObj, aMemberFunction pFn, uint32_t ticks )
+{
+	for ( auto& cb : m_callBacks )
+	{
+		if ( !cb.inUse )
+		{
+			cb = { pObj, pFn, ticks * TICK_US, (uint32_t)micros(), true };
+			return true;
+		}
+	}
+	return false;
+}
+
+bool MNTimerLib::RemoveCallBack ( MNTimerClass* pObj, aMemberFunction pFn )
+{
+	bool bResult = false;
+	for ( auto& cb : m_callBacks )
+	{
+		if ( cb.inUse && cb.pObj == pObj && cb.pFn == pFn )
+		{
+			cb.inUse = false;
+			bResult = true;
+		}
+	}
+	return bResult;
+}
+
+void MNTimerLib::Service ()
+{
+	uint32_t nowUs = micros();
+	for ( auto& cb : m_callBacks )
+	{
+		if ( cb.inUse && nowUs - cb.lastUs >= cb.periodUs )
+		{
+			cb.lastUs = nowUs;
+			( cb.pObj->*cb.pFn )();
+		}
+	}
+}
+
+bool MNTimerLib::NextDue ( uint32_t& dueMs ) const
+{
+	bool bFound = false;
+	uint32_t nowUs = micros();
+	uint32_t nowMs = millis();
+	for ( const auto& cb : m_callBacks )
+	{
+		if ( cb.inUse )
+		{
+			uint32_t elapsedUs = nowUs - cb.lastUs;
+			uint32_t remainingMs = elapsedUs >= cb.periodUs ? 0 : ( cb.periodUs - elapsedUs + 999 ) / 1000;
+			uint32_t due = nowMs + remainingMs;
+			if ( !bFound || (int32_t)( due - dueMs ) < 0 )
+			{
+				dueMs = due;
+				bFound = true;
+			}
+		}
+	}
+	return bFound;
+}
@@ -0,0 +1,50 @@
+#pragma once
+/*
+ * MNTimerLib.h (native stand-in)
+ *
+ * Host version of the MNTimerLib callback timer.  Callbacks are scheduled in
+ * timer ticks (10 us, as on the board) and are fired by NativeHarness::Poll()
+ * once due, standing in for the TC interrupt.  Callbacks repeat until removed.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class MNTimerClass
+{
+};
+
+typedef void ( MNTimerClass::*aMemberFunction ) ();
+
+class MNTimerLib
+{
+public:
+	static constexpr uint8_t MAX_CALLBACKS = 8;
+	static constexpr uint32_t TICK_US = 10;
+
+	bool AddCallBack ( MNTimerClass* pObj, aMemberFunction pFn, uint32_t ticks );
+	bool RemoveCallBack ( MNTimerClass* pObj, aMemberFunction pFn );
+
+	// Fires all callbacks whose period has elapsed; called by NativeHarness.
+	void Service ();
+
+	// Returns true and sets dueMs to the earliest callback deadline, if any.
+	bool NextDue ( uint32_t& dueMs ) const;
+
+private:
+	struct CallBack
+	{
+		MNTimerClass* pObj;
+		aMemberFunction pFn;
+		uint32_t periodUs;
+		uint32_t lastUs;
+		bool inUse;
+	};
+	CallBack m_callBacks [ MAX_CALLBACKS ] = {};
+};
+
+extern MNTimerLib TheTimer;
@@ -0,0 +1,561 @@
+/*
+ * NativeHarness.cpp (native stand-in)
+ *
+ * See NativeHarness.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   Virtual-time simulation, link script lines and loop-stage timeline
+ *   Ver 1.2   GC_BENCH_DECODE runs the decode benchmark
+ *   Ver 1.3   Simulated runs check the status-screen uptime
+ */
+
+#include "NativeHarness.h"
+
+#include "Display.h"
+#include "InputPin.h"
+#include "LoopStages.h"
+#include "MNTimerLib.h"
+
+#include <signal.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <WiFiNINA.h>
+
+#include <algorithm>
+#include <vector>
+
+extern Display* pMyDisplay;
+
+namespace
+{
+struct PinEvent
+{
+	uint64_t atMs;  // script: ms since the run started; pending edge: unused
+	pin_size_t pin;
+	PinStatus level;
+	bool bLink;  // script line "<ms> link <0|1>" rather than a pin level
+};
+
+const char* const STAGE_NAMES [] = { "led", "onboarding", "udp", "sensor", "display", "door", "sendq" };
+static_assert ( sizeof ( STAGE_NAMES ) / sizeof ( STAGE_NAMES [ 0 ] ) == (size_t)LoopStage::Count,
+    "STAGE_NAMES must cover every LoopStage" );
+
+std::vector<InputPin*> s_inputPins;
+std::vector<PinEvent> s_script;
+size_t s_nextScript = 0;
+std::vector<PinEvent> s_pendingEdges;
+bool s_bInterruptsEnabled = true;
+bool s_bInPoll = false;
+char** s_argv = nullptr;
+volatile sig_atomic_t s_linkToggleRequests = 0;
+
+// run time = s_carriedMs + clock time since s_originUs; s_carriedMs is non-zero
+// only after a simulated board reset, so the script and run length carry on
+uint64_t s_originUs = 0;
+uint64_t s_carriedMs = 0;
+uint64_t s_epochBase = 0;  // UnixTime() at run time 0
+
+// simulation
+uint64_t s_simEndMs = 0;
+uint64_t s_simStepUs = 20000ULL;
+uint64_t s_wallStartNs = 0;
+int64_t s_uptimeOffsetMs = 0;  // clock time since s_originUs minus the display uptime, after setup()
+
+// loop-stage timeline
+FILE* s_timeline = nullptr;
+uint64_t s_timelineIntervalUs = 1000000ULL;
+uint64_t s_intervalStartUs = 0;
+#ifdef LOOP_TRACE
+int s_stage = -1;  // stage being timed, -1 between passes
+uint64_t s_passStartUs = 0;
+uint64_t s_stageStartUs = 0;
+#endif
+uint32_t s_intervalPasses = 0;
+uint64_t s_intervalPassTotalUs = 0;
+uint32_t s_intervalPassMaxUs = 0;
+uint32_t s_intervalStageMaxUs [ (size_t)LoopStage::Count ] = {};
+char s_notes [ 256 ] = "";
+uint64_t s_totalPasses = 0;
+uint32_t s_worstPassUs = 0;
+uint64_t s_worstPassAtMs = 0;
+
+uint64_t WallNanos ()
+{
+	timespec ts;
+	clock_gettime ( CLOCK_MONOTONIC, &ts );
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint64_t EnvU64 ( const char* name, uint64_t defaultValue )
+{
+	const char* value = getenv ( name );
+	return value != nullptr && *value != '\0' ? strtoull ( value, nullptr, 10 ) : defaultValue;
+}
+
+void SetEnvU64 ( const char* name, uint64_t value )
+{
+	char text [ 24 ];
+	snprintf ( text, sizeof ( text ), "%llu", (unsigned long long)value );
+	setenv ( name, text, 1 );
+}
+
+uint64_t RunMs ()
+{
+	return s_carriedMs + ( NativeHarness::ClockMicros() - s_originUs ) / 1000ULL;
+}
+
+uint64_t RunMsToClockUs ( uint64_t runMs )
+{
+	return runMs <= s_carriedMs ? s_originUs : s_originUs + ( runMs - s_carriedMs ) * 1000ULL;
+}
+
+void OnSigUsr1 ( int )
+{
+	s_linkToggleRequests = s_linkToggleRequests + 1;
+}
+
+void LoadPinScript ()
+{
+	const char* path = getenv ( "GC_PIN_SCRIPT" );
+	if ( path == nullptr || *path == '\0' )
+	{
+		return;
+	}
+	FILE* f = fopen ( path, "r" );
+	if ( f == nullptr )
+	{
+		fprintf ( stderr, "NativeHarness: cannot open pin script %s\n", path );
+		return;
+	}
+	char line [ 128 ];
+	while ( fgets ( line, sizeof ( line ), f ) != nullptr )
+	{
+		unsigned long long atMs;
+		unsigned pin;
+		unsigned level;
+		if ( line [ 0 ] == '#' )
+		{
+			continue;
+		}
+		if ( sscanf ( line, "%llu link %u", &atMs, &level ) == 2 )
+		{
+			s_script.push_back ( { atMs, NOT_A_PIN, level ? HIGH : LOW, true } );
+		}
+		else if ( sscanf ( line, "%llu %u %u", &atMs, &pin, &level ) == 3 )
+		{
+			s_script.push_back ( { atMs, (pin_size_t)pin, level ? HIGH : LOW, false } );
+		}
+	}
+	fclose ( f );
+	std::stable_sort ( s_script.begin(), s_script.end(), [] ( const PinEvent& a, const PinEvent& b ) {
+		return a.atMs < b.atMs;
+	} );
+}
+
+void Note ( const char* fmt, ... )
+{
+	if ( s_timeline == nullptr )
+	{
+		return;
+	}
+	size_t used = strlen ( s_notes );
+	if ( used != 0 && used < sizeof ( s_notes ) - 1 )
+	{
+		s_notes [ used++ ] = ' ';
+		s_notes [ used ] = '\0';
+	}
+	va_list args;
+	va_start ( args, fmt );
+	vsnprintf ( s_notes + used, sizeof ( s_notes ) - used, fmt, args );
+	va_end ( args );
+}
+
+void OpenTimeline ()
+{
+	const char* path = getenv ( "GC_TIMELINE" );
+	if ( path == nullptr || *path == '\0' )
+	{
+		return;
+	}
+	bool bAppend = getenv ( "GC_TIMELINE_APPEND" ) != nullptr;
+	s_timeline = fopen ( path, bAppend ? "a" : "w" );
+	if ( s_timeline == nullptr )
+	{
+		fprintf ( stderr, "NativeHarness: cannot open timeline %s\n", path );
+		return;
+	}
+	s_timelineIntervalUs = EnvU64 ( "GC_TIMELINE_MS", 1000ULL ) * 1000ULL;
+	if ( s_timelineIntervalUs == 0 )
+	{
+		s_timelineIntervalUs = 1000ULL;
+	}
+	if ( !bAppend )
+	{
+		fprintf ( s_timeline, "run_ms,millis,passes,pass_avg_us,pass_max_us" );
+		for ( const char* name : STAGE_NAMES )
+		{
+			fprintf ( s_timeline, ",%s_max_us", name );
+		}
+		fprintf ( s_timeline, ",events\n" );
+	}
+	s_intervalStartUs = NativeHarness::ClockMicros();
+}
+
+// Writes one timeline row for the interval just ended and starts the next.
+void WriteTimelineRow ()
+{
+	if ( s_timeline == nullptr )
+	{
+		return;
+	}
+	uint64_t passAvgUs = s_intervalPasses != 0 ? s_intervalPassTotalUs / s_intervalPasses : 0;
+	fprintf ( s_timeline, "%llu,%lu,%u,%llu,%u", (unsigned long long)RunMs(), millis(), s_intervalPasses,
+	    (unsigned long long)passAvgUs, s_intervalPassMaxUs );
+	for ( uint32_t& stageMaxUs : s_intervalStageMaxUs )
+	{
+		fprintf ( s_timeline, ",%u", stageMaxUs );
+		stageMaxUs = 0;
+	}
+	fprintf ( s_timeline, ",%s\n", s_notes );
+	fflush ( s_timeline );  // rows survive the process being killed
+	s_notes [ 0 ] = '\0';
+	s_intervalPasses = 0;
+	s_intervalPassTotalUs = 0;
+	s_intervalPassMaxUs = 0;
+	s_intervalStartUs = NativeHarness::ClockMicros();
+}
+
+void StartSimulation ()
+{
+	uint64_t seconds = EnvU64 ( "GC_SIM_SECONDS", 0 );
+	if ( seconds == 0 )
+	{
+		return;
+	}
+	s_simEndMs = seconds * 1000ULL;
+	s_simStepUs = EnvU64 ( "GC_SIM_STEP_MS", 20 ) * 1000ULL;
+	if ( s_simStepUs == 0 )
+	{
+		s_simStepUs = 1000ULL;
+	}
+	s_carriedMs = EnvU64 ( "GC_SIM_ELAPSED_MS", 0 );
+	NativeHarness::StartVirtualClock ( EnvU64 ( "GC_SIM_START_MS", 0 ) * 1000ULL );
+	s_wallStartNs = WallNanos();
+}
+
+// Time since setup() returned, from the clock, and as the display has counted it.
+int64_t ClockSinceOriginMs ()
+{
+	return (int64_t)( ( NativeHarness::ClockMicros() - s_originUs ) / 1000ULL );
+}
+
+// The status-screen uptime must follow the clock, across a millis() wrap included.
+bool CheckUptime ()
+{
+	if ( pMyDisplay == nullptr )
+	{
+		return true;
+	}
+	int64_t expectedMs = ClockSinceOriginMs() - s_uptimeOffsetMs;
+	int64_t uptimeMs = (int64_t)pMyDisplay->GetUptimeMs();
+	if ( std::abs ( uptimeMs - expectedMs ) > 1000 )
+	{
+		fprintf ( stderr, "NativeHarness: display uptime %lld ms, expected %lld ms\n", (long long)uptimeMs,
+		    (long long)expectedMs );
+		return false;
+	}
+	return true;
+}
+
+[[noreturn]] void FinishSimulation ()
+{
+	WriteTimelineRow();
+	if ( s_timeline != nullptr )
+	{
+		fclose ( s_timeline );
+	}
+	double wallSeconds = ( WallNanos() - s_wallStartNs ) / 1e9;
+	fprintf ( stderr,
+	    "NativeHarness: simulated %.1f h in %.2f s wall; %llu passes, worst pass %u us at run %llu ms\n",
+	    RunMs() / 3600000.0, wallSeconds, (unsigned long long)s_totalPasses, s_worstPassUs,
+	    (unsigned long long)s_worstPassAtMs );
+	int status = CheckUptime() ? 0 : 1;
+	fflush ( nullptr );
+	exit ( status );
+}
+
+// Earliest clock time at which the harness knows something will happen: the
+// next script event, the next MNTimerLib callback or the end of the run.
+uint64_t NextDeadlineUs ()
+{
+	uint64_t nowUs = NativeHarness::ClockMicros();
+	uint64_t dueUs = RunMsToClockUs ( s_simEndMs );
+	if ( s_nextScript < s_script.size() )
+	{
+		dueUs = std::min ( dueUs, RunMsToClockUs ( s_script [ s_nextScript ].atMs ) );
+	}
+	uint32_t timerDueMs;
+	if ( s_bInterruptsEnabled && TheTimer.NextDue ( timerDueMs ) )
+	{
+		int32_t remainingMs = (int32_t)( timerDueMs - (uint32_t)millis() );
+		dueUs = std::min<uint64_t> ( dueUs, nowUs + (uint64_t)std::max<int32_t> ( remainingMs, 0 ) * 1000ULL );
+	}
+	return std::max ( dueUs, nowUs );
+}
+
+void CheckSimulationEnd ()
+{
+	if ( RunMs() >= s_simEndMs )
+	{
+		FinishSimulation();
+	}
+}
+
+void DeliverEdge ( pin_size_t pin, PinStatus level )
+{
+	for ( InputPin* pInput : s_inputPins )
+	{
+		if ( pInput->GetPin() == pin )
+		{
+			pInput->OnEdge ( level );
+		}
+	}
+}
+
+void DeliverPendingEdges ()
+{
+	if ( !s_bInterruptsEnabled || s_pendingEdges.empty() )
+	{
+		return;
+	}
+	std::vector<PinEvent> edges;
+	edges.swap ( s_pendingEdges );
+	for ( const PinEvent& e : edges )
+	{
+		DeliverEdge ( e.pin, e.level );
+	}
+}
+
+void SetLink ( bool bUp )
+{
+	if ( WiFi.IsLinkUp() == bUp )
+	{
+		return;
+	}
+	WiFi.SetLinkUp ( bUp );
+	fprintf ( stderr, "[%lu] WiFi link %s\n", millis(), bUp ? "up" : "down" );
+	Note ( "link=%d", bUp ? 1 : 0 );
+}
+}  // namespace
+
+namespace NativeHarness
+{
+void Poll ()
+{
+	if ( s_bInPoll )
+	{
+		return;
+	}
+	s_bInPoll = true;
+	while ( s_linkToggleRequests > 0 )
+	{
+		s_linkToggleRequests = s_linkToggleRequests - 1;
+		SetLink ( !WiFi.IsLinkUp() );
+	}
+	uint64_t nowMs = RunMs();
+	while ( s_nextScript < s_script.size() && s_script [ s_nextScript ].atMs <= nowMs )
+	{
+		const PinEvent& e = s_script [ s_nextScript++ ];
+		if ( e.bLink )
+		{
+			SetLink ( e.level == HIGH );
+		}
+		else
+		{
+			SetPin ( e.pin, e.level );
+		}
+	}
+	DeliverPendingEdges();
+	if ( s_bInterruptsEnabled )
+	{
+		TheTimer.Service();
+	}
+	s_bInPoll = false;
+}
+
+void RunUntil ( uint64_t untilUs )
+{
+	for ( ;; )
+	{
+		Poll();
+		uint64_t nowUs = ClockMicros();
+		if ( nowUs >= untilUs )
+		{
+			return;
+		}
+		AdvanceClockTo ( std::min ( untilUs, NextDeadlineUs() ) );
+		CheckSimulationEnd();
+	}
+}
+
+unsigned long UnixTime ()
+{
+	return (unsigned long)( s_epochBase + RunMs() / 1000ULL );
+}
+
+void SetPin ( pin_size_t pin, PinStatus level )
+{
+	if ( digitalRead ( pin ) == level )
+	{
+		return;
+	}
+	digitalWrite ( pin, level );
+	Note ( "pin%u=%d", (unsigned)pin, level == HIGH ? 1 : 0 );
+	if ( s_bInterruptsEnabled )
+	{
+		DeliverEdge ( pin, level );
+	}
+	else
+	{
+		s_pendingEdges.push_back ( { 0, pin, level, false } );
+	}
+}
+
+void RegisterInputPin ( InputPin* pPin )
+{
+	s_inputPins.push_back ( pPin );
+}
+
+void UnregisterInputPin ( InputPin* pPin )
+{
+	s_inputPins.erase ( std::remove ( s_inputPins.begin(), s_inputPins.end(), pPin ), s_inputPins.end() );
+}
+
+void SetInterruptsEnabled ( bool enabled )
+{
+	s_bInterruptsEnabled = enabled;
+	if ( enabled && !s_bInPoll )
+	{
+		DeliverPendingEdges();
+	}
+}
+
+bool InterruptsEnabled ()
+{
+	return s_bInterruptsEnabled;
+}
+
+void Restart ()
+{
+	fprintf ( stderr, "NativeHarness: board reset\n" );
+	if ( IsVirtualClock() )
+	{
+		// a reset restarts millis() from zero, but the run, the script and the
+		// wall clock carry on where they were
+		SetEnvU64 ( "GC_SIM_ELAPSED_MS", RunMs() );
+		SetEnvU64 ( "GC_SIM_START_MS", 0 );
+		SetEnvU64 ( "GC_SIM_EPOCH", s_epochBase );
+	}
+	if ( s_timeline != nullptr )
+	{
+		Note ( "reset" );
+		WriteTimelineRow();
+		fclose ( s_timeline );
+		setenv ( "GC_TIMELINE_APPEND", "1", 1 );
+	}
+	fflush ( nullptr );
+	execv ( "/proc/self/exe", s_argv );
+	_exit ( 1 );
+}
+}  // namespace NativeHarness
+
+int main ( int, char** argv )
+{
+	s_argv = argv;
+	setvbuf ( stdout, nullptr, _IOLBF, 0 );
+	if ( getenv ( "GC_BENCH_DECODE" ) != nullptr )
+	{
+		return NativeHarness::RunDecodeBenchmark();
+	}
+	millis();  // latch the time origin
+	StartSimulation();
+	s_originUs = NativeHarness::ClockMicros();
+	s_epochBase = EnvU64 ( "GC_SIM_EPOCH", (uint64_t)time ( nullptr ) );
+	signal ( SIGUSR1, OnSigUsr1 );
+	LoadPinScript();
+	OpenTimeline();
+	NativeHarness::Poll();  // after a simulated reset, restore the levels the script had already set
+	setup();
+	if ( pMyDisplay != nullptr )
+	{
+		s_uptimeOffsetMs = ClockSinceOriginMs() - (int64_t)pMyDisplay->GetUptimeMs();
+	}
+	for ( ;; )
+	{
+		loop();
+		NativeHarness::Poll();
+		if ( NativeHarness::IsVirtualClock() )
+		{
+			// idle: jump to the next known deadline, but never further than one
+			// step so the sketch still polls its own millis() intervals
+			NativeHarness::AdvanceClockTo ( std::min ( NativeHarness::ClockMicros() + s_simStepUs, NextDeadlineUs() ) );
+			CheckSimulationEnd();
+		}
+		else
+		{
+			usleep ( 100 );
+		}
+	}
+}
+
+// ─── Loop-stage timeline ──────────────────────────────────────────────────────
+
+#ifdef LOOP_TRACE
+void LoopTraceStage ( LoopStage stage )
+{
+	uint64_t nowUs = NativeHarness::ClockMicros();
+	if ( s_stage < 0 )
+	{
+		s_passStartUs = nowUs;
+	}
+	else
+	{
+		uint32_t stageUs = (uint32_t)( nowUs - s_stageStartUs );
+		s_intervalStageMaxUs [ s_stage ] = std::max ( s_intervalStageMaxUs [ s_stage ], stageUs );
+	}
+	s_stage = (int)stage;
+	s_stageStartUs = nowUs;
+}
+
+void LoopTracePassEnd ()
+{
+	if ( s_stage < 0 )
+	{
+		return;
+	}
+	uint64_t nowUs = NativeHarness::ClockMicros();
+	uint32_t stageUs = (uint32_t)( nowUs - s_stageStartUs );
+	s_intervalStageMaxUs [ s_stage ] = std::max ( s_intervalStageMaxUs [ s_stage ], stageUs );
+	s_stage = -1;
+
+	uint32_t passUs = (uint32_t)( nowUs - s_passStartUs );
+	s_intervalPasses++;
+	s_intervalPassTotalUs += passUs;
+	s_intervalPassMaxUs = std::max ( s_intervalPassMaxUs, passUs );
+	s_totalPasses++;
+	if ( passUs > s_worstPassUs )
+	{
+		s_worstPassUs = passUs;
+		s_worstPassAtMs = RunMs();
+	}
+	if ( nowUs - s_intervalStartUs >= s_timelineIntervalUs )
+	{
+		WriteTimelineRow();
+	}
+}
+#endif
@@ -0,0 +1,102 @@
+#pragma once
+/*
+ * NativeHarness.h (native stand-in)
+ *
+ * Host-side driver for the env:native build.  Owns main(), runs the sketch's
+ * setup() / loop(), delivers scripted pin edges to InputPin objects (standing
+ * in for the EIC interrupts), fires MNTimerLib callbacks and emulates
+ * NVIC_SystemReset() by re-executing the process.
+ *
+ * Simulation mode (GC_SIM_SECONDS set) replaces the real clock with a virtual
+ * one.  It advances at real speed while a loop() pass runs, so the stage
+ * timings below are genuine host timings, but between passes and inside
+ * delay() it jumps straight to the next deadline the harness knows about
+ * (script event, MNTimerLib callback, end of run), at most GC_SIM_STEP_MS at
+ * a time because the sketch's own millis() intervals are polled.  Weeks of
+ * door cycles and link drops, including the 49.7-day millis() wrap, then run
+ * in seconds; on exit a one-line summary goes to stderr.  The run also checks
+ * that the status-screen uptime (Display::GetUptimeMs()) has kept pace with
+ * the clock and exits with status 1 if not; started with GC_SIM_START_MS just
+ * short of 2^32 that covers the wrap, e.g.
+ *   GC_SIM_START_MS=4294900000 GC_SIM_SECONDS=600 .pio/build/native/program
+ *
+ * With LOOP_TRACE defined the harness implements the LoopStages.h markers and,
+ * when GC_TIMELINE is set, writes a CSV timeline: one row per GC_TIMELINE_MS
+ * of run time with the pass count, mean and worst pass time, the worst time of
+ * each loop stage and any script events, link changes or resets in the row.
+ *
+ * Environment variables:
+ *   GC_PIN_SCRIPT   path of a pin script; each line is "<ms> <pin> <0|1>",
+ *                   which drives <pin> to the given level at <ms> after start,
+ *                   or "<ms> link <0|1>", which drops or restores the WiFi link
+ *   GC_SIM_SECONDS  run simulated for this many seconds of virtual time, then exit
+ *   GC_SIM_START_MS initial millis() value, e.g. 4294900000 to cross the wrap
+ *                   a minute in (default 0)
+ *   GC_SIM_STEP_MS  longest idle jump between passes (default 20, the
+ *                   sketch's finest polled interval, SEND_QUEUE_PACING_MS)
+ *   GC_SIM_EPOCH    Unix time reported by WiFi.getTime() at the start of a
+ *                   simulated run (default: the host's time)
+ *   GC_TIMELINE     path of the loop-stage timeline CSV (LOOP_TRACE builds)
+ *   GC_TIMELINE_MS  run time covered by each timeline row (default 1000)
+ *   GC_CONFIG_FILE  path of the persisted GarageConfig blob (default
+ *                   ./garageconfig.blob)
+ *   GC_ONBOARD_SSID / GC_ONBOARD_PASSWORD / GC_ONBOARD_FIELDS
+ *                   submitted automatically by the onboarding portal stand-in
+ *                   on first boot (see OnboardingPortal.h)
+ *   GC_BENCH_DECODE run the V001 request decode benchmark instead of the
+ *                   sketch and exit (see DecodeBenchmark.cpp)
+ *   GC_BENCH_ITERATIONS
+ *                   decodes per message and decoder in the benchmark
+ *                   (default 200000)
+ *
+ * Sending SIGUSR1 to the process toggles the simulated WiFi link.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   Virtual-time simulation, link script lines and loop-stage timeline
+ *   Ver 1.2   Decode benchmark
+ *   Ver 1.3   Uptime check at the end of a simulated run
+ */
+
+#include <Arduino.h>
+
+class InputPin;
+
+namespace NativeHarness
+{
+// Runs due timer callbacks and scripted pin events; called between loop() passes
+// and from inside delay().
+void Poll ();
+
+// Simulation only: polls and jumps the virtual clock from deadline to deadline
+// until it reaches untilUs.  This is what delay() does in a simulated run.
+void RunUntil ( uint64_t untilUs );
+
+// Virtual clock, implemented in Arduino.cpp.  ClockMicros() is the 64-bit time
+// behind millis() / micros(); AdvanceClockTo() never moves it backwards.
+void StartVirtualClock ( uint64_t startUs );
+bool IsVirtualClock ();
+uint64_t ClockMicros ();
+void AdvanceClockTo ( uint64_t us );
+
+// Seconds since 1970 as reported by WiFi.getTime(); follows the virtual clock.
+unsigned long UnixTime ();
+
+// Drives an input pin to a level and delivers the resulting edge to any InputPin
+// attached to it (deferred while interrupts are disabled).
+void SetPin ( pin_size_t pin, PinStatus level );
+
+void RegisterInputPin ( InputPin* pPin );
+void UnregisterInputPin ( InputPin* pPin );
+
+void SetInterruptsEnabled ( bool enabled );
+bool InterruptsEnabled ();
+
+// Re-executes the current process, emulating a board reset.
+[[noreturn]] void Restart ();
+
+// Times the old and table-driven V001 request decoders; returns the exit status.
+int RunDecodeBenchmark ();
+}  // namespace NativeHarness
@@ -0,0 +1,82 @@
+#pragma once
+/*
+ * OnboardingPortal.h (native stand-in)
+ *
+ * Host version of the captive onboarding portal.  If GC_ONBOARD_SSID is set
+ * the first loop() submits it (with GC_ONBOARD_PASSWORD and the optional
+ * URL-encoded GC_ONBOARD_FIELDS) through the server, and on success resets the
+ * "board" just as the real portal does after saving.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "OnboardingServerBase.h"
+
+#include <IPAddress.h>
+
+#include <functional>
+
+class OnboardingPortal
+{
+public:
+	OnboardingPortal ( OnboardingServerBase& server, const char*, const char* ) : m_server ( server )
+	{
+	}
+
+	bool begin ()
+	{
+		return true;
+	}
+
+	void loop ()
+	{
+		if ( m_bSubmitted )
+		{
+			return;
+		}
+		m_bSubmitted = true;
+		const char* ssid = getenv ( "GC_ONBOARD_SSID" );
+		if ( ssid == nullptr || *ssid == '\0' )
+		{
+			return;
+		}
+		const char* password = getenv ( "GC_ONBOARD_PASSWORD" );
+		const char* fields = getenv ( "GC_ONBOARD_FIELDS" );
+		if ( m_onClientConnected )
+		{
+			m_onClientConnected();
+		}
+		if ( m_server.Submit ( ssid, password != nullptr ? password : "", String ( fields != nullptr ? fields : "" ) ) )
+		{
+			NVIC_SystemReset();
+		}
+		if ( m_onClientDisconnected )
+		{
+			m_onClientDisconnected();
+		}
+	}
+
+	void setOnClientConnected ( std::function<void ()> fn )
+	{
+		m_onClientConnected = fn;
+	}
+
+	void setOnClientDisconnected ( std::function<void ()> fn )
+	{
+		m_onClientDisconnected = fn;
+	}
+
+	IPAddress apIP () const
+	{
+		return IPAddress ( 192, 168, 4, 1 );
+	}
+
+private:
+	OnboardingServerBase& m_server;
+	bool m_bSubmitted = false;
+	std::function<void ()> m_onClientConnected;
+	std::function<void ()> m_onClientDisconnected;
+};
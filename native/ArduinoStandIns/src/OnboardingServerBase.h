@@ -0,0 +1,62 @@
+#pragma once
+/*
+ * OnboardingServerBase.h (native stand-in)
+ *
+ * Host version of the onboarding form server base class.  There is no HTTP
+ * server; OnboardingPortal submits credentials taken from the environment
+ * through Submit(), which drives the same virtual hooks as a real form POST.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class OnboardingServerBase
+{
+public:
+	explicit OnboardingServerBase ( uint16_t port ) : m_port ( port )
+	{
+	}
+	virtual ~OnboardingServerBase () = default;
+
+	// Emulates a successful form submission; returns the result of saveConfiguration().
+	bool Submit ( const char* ssid, const char* password, const String& body )
+	{
+		strncpy ( _wifiSsid, ssid, sizeof ( _wifiSsid ) - 1 );
+		strncpy ( _wifiPassword, password, sizeof ( _wifiPassword ) - 1 );
+		return parseAdditionalFields ( body ) && saveConfiguration();
+	}
+
+protected:
+	virtual String getFormTitle () const = 0;
+	virtual String getAdditionalFields () const = 0;
+	virtual String getAdditionalValidation () const = 0;
+	virtual bool parseAdditionalFields ( const String& body ) = 0;
+	virtual bool saveConfiguration () = 0;
+	virtual String getFooterContent () const = 0;
+
+	char _wifiSsid [ 33 ] = {};
+	char _wifiPassword [ 65 ] = {};
+
+	// Returns the value of field in a URL-encoded body; the value ends at the next
+	// '&' (nextField only documents the expected order, as in the library).
+	static String extractField ( const String& body, const char* field, const char* nextField = nullptr )
+	{
+		(void)nextField;
+		String key = String ( field ) + "=";
+		int start = body.indexOf ( key );
+		if ( start < 0 )
+		{
+			return String();
+		}
+		start += key.length();
+		int end = body.indexOf ( '&', start );
+		return end < 0 ? body.substring ( start ) : body.substring ( start, end );
+	}
+
+private:
+	uint16_t m_port;
+};
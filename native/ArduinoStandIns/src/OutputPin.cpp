@@ -0,0 +1,49 @@
+/*
+ * OutputPin.cpp (native stand-in)
+ *
+ * See OutputPin.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "OutputPin.h"
+
+OutputPin::OutputPin ( pin_size_t pin, PinStatus onValue ) : m_pin ( pin ), m_onValue ( onValue )
+{
+	if ( m_pin != NOT_A_PIN )
+	{
+		pinMode ( m_pin, OUTPUT );
+	}
+}
+
+void OutputPin::On ()
+{
+	Set ( true );
+}
+
+void OutputPin::Off ()
+{
+	Set ( false );
+}
+
+bool OutputPin::IsOn () const
+{
+	return m_bOn;
+}
+
+void OutputPin::Set ( bool bOn )
+{
+	if ( m_pin == NOT_A_PIN )
+	{
+		return;
+	}
+	if ( bOn != m_bOn )
+	{
+		fprintf ( stderr, "[%lu] pin %u %s\n", millis(), (unsigned)m_pin, bOn ? "ON" : "off" );
+	}
+	m_bOn = bOn;
+	digitalWrite ( m_pin, bOn ? m_onValue : ( m_onValue == HIGH ? LOW : HIGH ) );
+}
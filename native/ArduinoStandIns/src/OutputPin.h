@@ -0,0 +1,29 @@
+#pragma once
+/*
+ * OutputPin.h (native stand-in)
+ *
+ * Host version of the digital output class.  Level changes are written to
+ * stderr so relay pulses are visible when running env:native.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class OutputPin
+{
+public:
+	OutputPin ( pin_size_t pin, PinStatus onValue = HIGH );
+	void On ();
+	void Off ();
+	bool IsOn () const;
+
+private:
+	const pin_size_t m_pin;
+	const PinStatus m_onValue;
+	bool m_bOn = false;
+	void Set ( bool bOn );
+};
@@ -0,0 +1,64 @@
+#pragma once
+/*
+ * Stream.h / Print.h (native stand-in)
+ *
+ * Print and Stream base classes with the subset of overloads GarageControl
+ * uses.  Numbers print in decimal, as on the board.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+class String;
+class __FlashStringHelper;
+
+class Print
+{
+public:
+	virtual ~Print () = default;
+	virtual size_t write ( uint8_t c ) = 0;
+	virtual size_t write ( const uint8_t* buffer, size_t size );
+	size_t write ( const char* str );
+	size_t write ( const char* buffer, size_t size )
+	{
+		return write ( (const uint8_t*)buffer, size );
+	}
+	virtual void flush ()
+	{
+	}
+
+	size_t print ( const String& s );
+	size_t print ( const char* s );
+	size_t print ( const __FlashStringHelper* s );
+	size_t print ( char c );
+	size_t print ( unsigned char n );
+	size_t print ( int n );
+	size_t print ( unsigned int n );
+	size_t print ( long n );
+	size_t print ( unsigned long n );
+	size_t print ( double n, int digits = 2 );
+
+	template <typename T>
+	size_t println ( const T& v )
+	{
+		size_t n = print ( v );
+		return n + print ( "\r\n" );
+	}
+	size_t println ()
+	{
+		return print ( "\r\n" );
+	}
+};
+
+class Stream : public Print
+{
+public:
+	virtual int available () = 0;
+	virtual int read () = 0;
+	virtual int peek () = 0;
+};
@@ -0,0 +1,48 @@
+#pragma once
+/*
+ * TypedBlobStorage.h (native stand-in)
+ *
+ * Type safe wrapper over a BlobStorage backend, as in the BlobStorage library.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "BlobStorage.h"
+
+template <typename T> class TypedBlobStorage
+{
+public:
+	TypedBlobStorage ( BlobStorage* pBackend, bool bOwnsBackend ) : m_pBackend ( pBackend ), m_bOwnsBackend ( bOwnsBackend )
+	{
+	}
+	~TypedBlobStorage ()
+	{
+		if ( m_bOwnsBackend )
+		{
+			delete m_pBackend;
+		}
+	}
+	BlobStorage::Error begin ()
+	{
+		return m_pBackend->begin();
+	}
+	BlobStorage::Error read ( T& value )
+	{
+		return m_pBackend->read ( &value, sizeof ( T ) );
+	}
+	BlobStorage::Error write ( const T& value )
+	{
+		return m_pBackend->write ( &value, sizeof ( T ) );
+	}
+	BlobStorage::Error clear ()
+	{
+		return m_pBackend->clear();
+	}
+
+private:
+	BlobStorage* m_pBackend;
+	bool m_bOwnsBackend;
+};
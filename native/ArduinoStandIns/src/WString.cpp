@@ -0,0 +1,325 @@
+/*
+ * WString.cpp (native stand-in)
+ *
+ * See WString.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "WString.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Arduino core number formatting helpers
+static std::string formatInteger ( unsigned long value, bool negative, unsigned char base )
+{
+	if ( base < 2 || base > 36 )
+	{
+		base = 10;
+	}
+	char buf [ 8 * sizeof ( long ) + 2 ];
+	char* p = &buf [ sizeof ( buf ) - 1 ];
+	*p = '\0';
+	do
+	{
+		unsigned long digit = value % base;
+		*--p = (char)( digit < 10 ? '0' + digit : 'A' + digit - 10 );
+		value /= base;
+	} while ( value != 0 );
+	if ( negative )
+	{
+		*--p = '-';
+	}
+	return std::string ( p );
+}
+
+static std::string formatSigned ( long value, unsigned char base )
+{
+	if ( value < 0 && base == 10 )
+	{
+		return formatInteger ( (unsigned long)( -( value + 1 ) ) + 1UL, true, base );
+	}
+	return formatInteger ( (unsigned long)value, false, base );
+}
+
+// Mirrors dtostrf ( value, 4 + decimals, decimals ) as used by the SAMD core
+static std::string formatFloat ( double value, unsigned char decimalPlaces )
+{
+	if ( isnan ( value ) )
+	{
+		return "nan";
+	}
+	if ( isinf ( value ) )
+	{
+		return "inf";
+	}
+	char buf [ 64 ];
+	snprintf ( buf, sizeof ( buf ), "%.*f", (int)decimalPlaces, value );
+	return std::string ( buf );
+}
+
+String::String ( const char* cstr ) : m_s ( cstr != nullptr ? cstr : "" )
+{
+}
+
+String::String ( const __FlashStringHelper* str ) : m_s ( str != nullptr ? (const char*)str : "" )
+{
+}
+
+String::String ( char c ) : m_s ( 1, c )
+{
+}
+
+String::String ( unsigned char value, unsigned char base ) : m_s ( formatInteger ( value, false, base ) )
+{
+}
+
+String::String ( int value, unsigned char base ) : m_s ( formatSigned ( value, base ) )
+{
+}
+
+String::String ( unsigned int value, unsigned char base ) : m_s ( formatInteger ( value, false, base ) )
+{
+}
+
+String::String ( long value, unsigned char base ) : m_s ( formatSigned ( value, base ) )
+{
+}
+
+String::String ( unsigned long value, unsigned char base ) : m_s ( formatInteger ( value, false, base ) )
+{
+}
+
+String::String ( float value, unsigned char decimalPlaces ) : m_s ( formatFloat ( value, decimalPlaces ) )
+{
+}
+
+String::String ( double value, unsigned char decimalPlaces ) : m_s ( formatFloat ( value, decimalPlaces ) )
+{
+}
+
+String& String::operator= ( const char* cstr )
+{
+	m_s = cstr != nullptr ? cstr : "";
+	return *this;
+}
+
+String& String::operator= ( const __FlashStringHelper* str )
+{
+	m_s = str != nullptr ? (const char*)str : "";
+	return *this;
+}
+
+unsigned char String::reserve ( unsigned int size )
+{
+	m_s.reserve ( size );
+	return 1;
+}
+
+unsigned char String::concat ( const String& str )
+{
+	m_s += str.m_s;
+	return 1;
+}
+
+unsigned char String::concat ( const char* cstr )
+{
+	if ( cstr == nullptr )
+	{
+		return 0;
+	}
+	m_s += cstr;
+	return 1;
+}
+
+unsigned char String::concat ( const char* cstr, unsigned int length )
+{
+	if ( cstr == nullptr )
+	{
+		return 0;
+	}
+	m_s.append ( cstr, length );
+	return 1;
+}
+
+unsigned char String::concat ( char c )
+{
+	m_s += c;
+	return 1;
+}
+
+unsigned char String::concat ( unsigned char num )
+{
+	m_s += formatInteger ( num, false, 10 );
+	return 1;
+}
+
+unsigned char String::concat ( int num )
+{
+	m_s += formatSigned ( num, 10 );
+	return 1;
+}
+
+unsigned char String::concat ( unsigned int num )
+{
+	m_s += formatInteger ( num, false, 10 );
+	return 1;
+}
+
+unsigned char String::concat ( long num )
+{
+	m_s += formatSigned ( num, 10 );
+	return 1;
+}
+
+unsigned char String::concat ( unsigned long num )
+{
+	m_s += formatInteger ( num, false, 10 );
+	return 1;
+}
+
+unsigned char String::concat ( float num )
+{
+	m_s += formatFloat ( num, 2 );
+	return 1;
+}
+
+unsigned char String::concat ( double num )
+{
+	m_s += formatFloat ( num, 2 );
+	return 1;
+}
+
+unsigned char String::concat ( const __FlashStringHelper* str )
+{
+	return concat ( (const char*)str );
+}
+
+int String::compareTo ( const String& s ) const
+{
+	return m_s.compare ( s.m_s );
+}
+
+unsigned char String::equals ( const String& s ) const
+{
+	return m_s == s.m_s;
+}
+
+unsigned char String::equals ( const char* cstr ) const
+{
+	return cstr != nullptr && m_s == cstr;
+}
+
+unsigned char String::startsWith ( const String& prefix ) const
+{
+	return startsWith ( prefix, 0 );
+}
+
+unsigned char String::startsWith ( const String& prefix, unsigned int offset ) const
+{
+	if ( offset > m_s.length() || prefix.m_s.length() > m_s.length() - offset )
+	{
+		return 0;
+	}
+	return m_s.compare ( offset, prefix.m_s.length(), prefix.m_s ) == 0;
+}
+
+unsigned char String::endsWith ( const String& suffix ) const
+{
+	if ( suffix.m_s.length() > m_s.length() )
+	{
+		return 0;
+	}
+	return m_s.compare ( m_s.length() - suffix.m_s.length(), suffix.m_s.length(), suffix.m_s ) == 0;
+}
+
+char String::charAt ( unsigned int index ) const
+{
+	return index < m_s.length() ? m_s [ index ] : 0;
+}
+
+char String::operator[] ( unsigned int index ) const
+{
+	return charAt ( index );
+}
+
+void String::toCharArray ( char* buf, unsigned int bufsize, unsigned int index ) const
+{
+	if ( buf == nullptr || bufsize == 0 )
+	{
+		return;
+	}
+	if ( index >= m_s.length() )
+	{
+		buf [ 0 ] = '\0';
+		return;
+	}
+	size_t n = std::min<size_t> ( bufsize - 1, m_s.length() - index );
+	memcpy ( buf, m_s.data() + index, n );
+	buf [ n ] = '\0';
+}
+
+int String::indexOf ( char ch, unsigned int fromIndex ) const
+{
+	size_t pos = m_s.find ( ch, fromIndex );
+	return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf ( const String& str, unsigned int fromIndex ) const
+{
+	size_t pos = m_s.find ( str.m_s, fromIndex );
+	return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring ( unsigned int beginIndex ) const
+{
+	return substring ( beginIndex, (unsigned int)m_s.length() );
+}
+
+String String::substring ( unsigned int beginIndex, unsigned int endIndex ) const
+{
+	if ( beginIndex > endIndex )
+	{
+		std::swap ( beginIndex, endIndex );
+	}
+	String result;
+	if ( beginIndex >= m_s.length() )
+	{
+		return result;
+	}
+	endIndex = std::min<unsigned int> ( endIndex, (unsigned int)m_s.length() );
+	result.m_s = m_s.substr ( beginIndex, endIndex - beginIndex );
+	return result;
+}
+
+void String::trim ()
+{
+	size_t begin = 0;
+	while ( begin < m_s.length() && isspace ( (unsigned char)m_s [ begin ] ) )
+	{
+		begin++;
+	}
+	size_t end = m_s.length();
+	while ( end > begin && isspace ( (unsigned char)m_s [ end - 1 ] ) )
+	{
+		end--;
+	}
+	m_s = m_s.substr ( begin, end - begin );
+}
+
+long String::toInt () const
+{
+	return atol ( m_s.c_str() );
+}
+
+float String::toFloat () const
+{
+	return (float)atof ( m_s.c_str() );
+}
@@ -0,0 +1,145 @@
+#pragma once
+/*
+ * WString.h (native stand-in)
+ *
+ * Arduino String class backed by std::string.  Numeric formatting follows the
+ * Arduino core (floats default to two decimal places) so that payloads built
+ * on the host are byte-identical to those built on the board.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+class __FlashStringHelper;
+#define F( string_literal ) ( reinterpret_cast<const __FlashStringHelper*> ( string_literal ) )
+#define PSTR( s ) ( s )
+
+class String
+{
+public:
+	String ( const char* cstr = "" );
+	String ( const String& str ) = default;
+	String ( String&& str ) = default;
+	String ( const __FlashStringHelper* str );
+	explicit String ( char c );
+	explicit String ( unsigned char value, unsigned char base = 10 );
+	explicit String ( int value, unsigned char base = 10 );
+	explicit String ( unsigned int value, unsigned char base = 10 );
+	explicit String ( long value, unsigned char base = 10 );
+	explicit String ( unsigned long value, unsigned char base = 10 );
+	explicit String ( float value, unsigned char decimalPlaces = 2 );
+	explicit String ( double value, unsigned char decimalPlaces = 2 );
+
+	String& operator= ( const String& rhs ) = default;
+	String& operator= ( String&& rhs ) = default;
+	String& operator= ( const char* cstr );
+	String& operator= ( const __FlashStringHelper* str );
+
+	unsigned char reserve ( unsigned int size );
+	unsigned int length () const
+	{
+		return (unsigned int)m_s.length();
+	}
+	const char* c_str () const
+	{
+		return m_s.c_str();
+	}
+
+	unsigned char concat ( const String& str );
+	unsigned char concat ( const char* cstr );
+	unsigned char concat ( const char* cstr, unsigned int length );
+	unsigned char concat ( char c );
+	unsigned char concat ( unsigned char num );
+	unsigned char concat ( int num );
+	unsigned char concat ( unsigned int num );
+	unsigned char concat ( long num );
+	unsigned char concat ( unsigned long num );
+	unsigned char concat ( float num );
+	unsigned char concat ( double num );
+	unsigned char concat ( const __FlashStringHelper* str );
+
+	template <typename T>
+	String& operator+= ( const T& rhs )
+	{
+		concat ( rhs );
+		return *this;
+	}
+
+	int compareTo ( const String& s ) const;
+	unsigned char equals ( const String& s ) const;
+	unsigned char equals ( const char* cstr ) const;
+	bool operator== ( const String& rhs ) const
+	{
+		return equals ( rhs );
+	}
+	bool operator== ( const char* cstr ) const
+	{
+		return equals ( cstr );
+	}
+	bool operator!= ( const String& rhs ) const
+	{
+		return !equals ( rhs );
+	}
+	bool operator!= ( const char* cstr ) const
+	{
+		return !equals ( cstr );
+	}
+	bool operator< ( const String& rhs ) const
+	{
+		return compareTo ( rhs ) < 0;
+	}
+	bool operator> ( const String& rhs ) const
+	{
+		return compareTo ( rhs ) > 0;
+	}
+
+	unsigned char startsWith ( const String& prefix ) const;
+	unsigned char startsWith ( const String& prefix, unsigned int offset ) const;
+	unsigned char endsWith ( const String& suffix ) const;
+
+	char charAt ( unsigned int index ) const;
+	char operator[] ( unsigned int index ) const;
+	void toCharArray ( char* buf, unsigned int bufsize, unsigned int index = 0 ) const;
+
+	int indexOf ( char ch, unsigned int fromIndex = 0 ) const;
+	int indexOf ( const String& str, unsigned int fromIndex = 0 ) const;
+	String substring ( unsigned int beginIndex ) const;
+	String substring ( unsigned int beginIndex, unsigned int endIndex ) const;
+
+	void trim ();
+	long toInt () const;
+	float toFloat () const;
+
+private:
+	std::string m_s;
+};
+
+// Arduino's StringSumHelper semantics: String + anything appends the textual form.
+template <typename T>
+String operator+ ( const String& lhs, const T& rhs )
+{
+	String result ( lhs );
+	result.concat ( rhs );
+	return result;
+}
+
+inline String operator+ ( const char* lhs, const String& rhs )
+{
+	String result ( lhs );
+	result.concat ( rhs );
+	return result;
+}
+
+inline String operator+ ( const __FlashStringHelper* lhs, const String& rhs )
+{
+	String result ( lhs );
+	result.concat ( rhs );
+	return result;
+}
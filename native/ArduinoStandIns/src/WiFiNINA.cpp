@@ -0,0 +1,422 @@
+/*
+ * WiFiNINA.cpp (native stand-in)
+ *
+ * See WiFiNINA.h and WiFiUdp.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   getTime() follows the harness clock
+ */
+
+#include "WiFiNINA.h"
+
+#include "NativeHarness.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+static void setNonBlocking ( int fd )
+{
+	int flags = fcntl ( fd, F_GETFL, 0 );
+	if ( flags >= 0 )
+	{
+		fcntl ( fd, F_SETFL, flags | O_NONBLOCK );
+	}
+}
+
+static IPAddress fromInAddr ( in_addr addr )
+{
+	return IPAddress ( (uint32_t)addr.s_addr );
+}
+
+static in_addr toInAddr ( IPAddress ip )
+{
+	in_addr addr;
+	addr.s_addr = (uint32_t)ip;
+	return addr;
+}
+
+// ─── WiFiClass ────────────────────────────────────────────────────────────────
+
+const char* WiFiClass::firmwareVersion ()
+{
+	return WIFI_FIRMWARE_LATEST_VERSION;
+}
+
+void WiFiClass::setTimeout ( unsigned long timeout )
+{
+	m_ulTimeoutMs = timeout;
+}
+
+int WiFiClass::begin ( const char* ssid, const char* )
+{
+	strncpy ( m_ssid, ssid != nullptr ? ssid : "", sizeof ( m_ssid ) - 1 );
+	m_status = WL_IDLE_STATUS;
+	m_bAssociating = true;
+	m_ulBeginMs = millis();
+	for ( uint32_t start = millis(); millis() - start < m_ulTimeoutMs && status() == WL_IDLE_STATUS; )
+	{
+		delay ( 100 );
+	}
+	return status();
+}
+
+uint8_t WiFiClass::beginAP ( const char* ssid, const char* )
+{
+	strncpy ( m_ssid, ssid != nullptr ? ssid : "", sizeof ( m_ssid ) - 1 );
+	m_status = WL_AP_LISTENING;
+	return m_status;
+}
+
+int WiFiClass::disconnect ()
+{
+	m_status = WL_DISCONNECTED;
+	return m_status;
+}
+
+void WiFiClass::end ()
+{
+	m_status = WL_IDLE_STATUS;
+}
+
+uint8_t WiFiClass::status ()
+{
+	if ( m_bAssociating && millis() - m_ulBeginMs >= ASSOCIATE_MS )
+	{
+		m_bAssociating = false;
+		m_status = m_bLinkUp ? WL_CONNECTED : WL_NO_SSID_AVAIL;
+	}
+	if ( m_status == WL_CONNECTED && !m_bLinkUp )
+	{
+		m_status = WL_CONNECTION_LOST;
+	}
+	return m_status;
+}
+
+void WiFiClass::SetLinkUp ( bool bUp )
+{
+	m_bLinkUp = bUp;
+}
+
+bool WiFiClass::IsLinkUp () const
+{
+	return m_bLinkUp;
+}
+
+void WiFiClass::setHostname ( const char* )
+{
+}
+
+const char* WiFiClass::SSID ()
+{
+	return m_ssid;
+}
+
+int32_t WiFiClass::RSSI ()
+{
+	return status() == WL_CONNECTED ? -50 : 0;
+}
+
+uint8_t* WiFiClass::macAddress ( uint8_t* mac )
+{
+	static const uint8_t hostMac [ 6 ] = { 0x01, 0x10, 0x00, 0xC0, 0xFF, 0xEE };
+	memcpy ( mac, hostMac, sizeof ( hostMac ) );
+	return mac;
+}
+
+void WiFiClass::QueryInterface ()
+{
+	if ( m_bQueried )
+	{
+		return;
+	}
+	m_bQueried = true;
+	m_localIP = IPAddress ( 127, 0, 0, 1 );
+	m_subnetMask = IPAddress ( 255, 0, 0, 0 );
+	ifaddrs* pList = nullptr;
+	if ( getifaddrs ( &pList ) == 0 )
+	{
+		for ( ifaddrs* p = pList; p != nullptr; p = p->ifa_next )
+		{
+			if ( p->ifa_addr == nullptr || p->ifa_addr->sa_family != AF_INET || ( p->ifa_flags & IFF_LOOPBACK ) )
+			{
+				continue;
+			}
+			m_localIP = fromInAddr ( ( (sockaddr_in*)p->ifa_addr )->sin_addr );
+			if ( p->ifa_netmask != nullptr )
+			{
+				m_subnetMask = fromInAddr ( ( (sockaddr_in*)p->ifa_netmask )->sin_addr );
+			}
+			break;
+		}
+		freeifaddrs ( pList );
+	}
+	// Assume the conventional .1 router on the local subnet
+	m_gatewayIP = IPAddress ( ( (uint32_t)m_localIP & (uint32_t)m_subnetMask ) | htonl ( 1 ) );
+}
+
+IPAddress WiFiClass::localIP ()
+{
+	QueryInterface();
+	return status() == WL_CONNECTED ? m_localIP : IPAddress ( 0UL );
+}
+
+IPAddress WiFiClass::subnetMask ()
+{
+	QueryInterface();
+	return status() == WL_CONNECTED ? m_subnetMask : IPAddress ( 0UL );
+}
+
+IPAddress WiFiClass::gatewayIP ()
+{
+	QueryInterface();
+	return status() == WL_CONNECTED ? m_gatewayIP : IPAddress ( 0UL );
+}
+
+unsigned long WiFiClass::getTime ()
+{
+	return status() == WL_CONNECTED ? NativeHarness::UnixTime() : 0UL;
+}
+
+// ─── WiFiClient ───────────────────────────────────────────────────────────────
+
+uint8_t WiFiClient::connected ()
+{
+	if ( m_fd < 0 )
+	{
+		return 0;
+	}
+	char c;
+	ssize_t n = recv ( m_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT );
+	if ( n == 0 || ( n < 0 && errno != EAGAIN && errno != EWOULDBLOCK ) )
+	{
+		return 0;
+	}
+	return 1;
+}
+
+int WiFiClient::available ()
+{
+	if ( m_fd < 0 )
+	{
+		return 0;
+	}
+	char buf [ 256 ];
+	ssize_t n = recv ( m_fd, buf, sizeof ( buf ), MSG_PEEK | MSG_DONTWAIT );
+	return n > 0 ? (int)n : 0;
+}
+
+int WiFiClient::read ()
+{
+	unsigned char c;
+	return ( m_fd >= 0 && recv ( m_fd, &c, 1, MSG_DONTWAIT ) == 1 ) ? c : -1;
+}
+
+int WiFiClient::peek ()
+{
+	unsigned char c;
+	return ( m_fd >= 0 && recv ( m_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT ) == 1 ) ? c : -1;
+}
+
+size_t WiFiClient::write ( uint8_t c )
+{
+	return write ( &c, 1 );
+}
+
+size_t WiFiClient::write ( const uint8_t* buffer, size_t size )
+{
+	if ( m_fd < 0 )
+	{
+		return 0;
+	}
+	ssize_t n = send ( m_fd, buffer, size, MSG_NOSIGNAL | MSG_DONTWAIT );
+	return n > 0 ? (size_t)n : 0;
+}
+
+void WiFiClient::stop ()
+{
+	if ( m_fd >= 0 )
+	{
+		close ( m_fd );
+		m_fd = -1;
+	}
+}
+
+// ─── WiFiServer ───────────────────────────────────────────────────────────────
+
+void WiFiServer::begin ()
+{
+	m_fd = socket ( AF_INET, SOCK_STREAM, 0 );
+	if ( m_fd < 0 )
+	{
+		return;
+	}
+	int on = 1;
+	setsockopt ( m_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof ( on ) );
+	sockaddr_in addr = {};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons ( m_port );
+	addr.sin_addr.s_addr = htonl ( INADDR_ANY );
+	if ( bind ( m_fd, (sockaddr*)&addr, sizeof ( addr ) ) != 0 || listen ( m_fd, 1 ) != 0 )
+	{
+		close ( m_fd );
+		m_fd = -1;
+		return;
+	}
+	setNonBlocking ( m_fd );
+}
+
+WiFiClient WiFiServer::available ()
+{
+	if ( m_fd < 0 )
+	{
+		return WiFiClient();
+	}
+	int fd = accept ( m_fd, nullptr, nullptr );
+	if ( fd < 0 )
+	{
+		return WiFiClient();
+	}
+	setNonBlocking ( fd );
+	return WiFiClient ( fd );
+}
+
+// ─── WiFiUDP ──────────────────────────────────────────────────────────────────
+
+uint8_t WiFiUDP::begin ( uint16_t port )
+{
+	stop();
+	m_fd = socket ( AF_INET, SOCK_DGRAM, 0 );
+	if ( m_fd < 0 )
+	{
+		return 0;
+	}
+	int on = 1;
+	setsockopt ( m_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof ( on ) );
+	setsockopt ( m_fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof ( on ) );
+	sockaddr_in addr = {};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons ( port );
+	addr.sin_addr.s_addr = htonl ( INADDR_ANY );
+	if ( bind ( m_fd, (sockaddr*)&addr, sizeof ( addr ) ) != 0 )
+	{
+		close ( m_fd );
+		m_fd = -1;
+		return 0;
+	}
+	setNonBlocking ( m_fd );
+	return 1;
+}
+
+void WiFiUDP::stop ()
+{
+	if ( m_fd >= 0 )
+	{
+		close ( m_fd );
+		m_fd = -1;
+	}
+	m_rxLength = m_rxPos = 0;
+}
+
+int WiFiUDP::beginPacket ( IPAddress ip, uint16_t port )
+{
+	if ( m_fd < 0 || WiFi.status() != WL_CONNECTED )
+	{
+		return 0;
+	}
+	m_txIP = ip;
+	m_txPort = port;
+	m_txLength = 0;
+	return 1;
+}
+
+int WiFiUDP::endPacket ()
+{
+	if ( m_fd < 0 || WiFi.status() != WL_CONNECTED )
+	{
+		return 0;
+	}
+	sockaddr_in addr = {};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons ( m_txPort );
+	addr.sin_addr = toInAddr ( m_txIP );
+	ssize_t n = sendto ( m_fd, m_txBuffer, m_txLength, 0, (sockaddr*)&addr, sizeof ( addr ) );
+	m_txLength = 0;
+	return n >= 0 ? 1 : 0;
+}
+
+size_t WiFiUDP::write ( uint8_t c )
+{
+	return write ( &c, 1 );
+}
+
+size_t WiFiUDP::write ( const uint8_t* buffer, size_t size )
+{
+	size_t n = std::min ( size, sizeof ( m_txBuffer ) - m_txLength );
+	memcpy ( m_txBuffer + m_txLength, buffer, n );
+	m_txLength += n;
+	return n;
+}
+
+int WiFiUDP::parsePacket ()
+{
+	m_rxLength = m_rxPos = 0;
+	if ( m_fd < 0 )
+	{
+		return 0;
+	}
+	sockaddr_in from = {};
+	socklen_t fromLen = sizeof ( from );
+	ssize_t n = recvfrom ( m_fd, m_rxBuffer, sizeof ( m_rxBuffer ), 0, (sockaddr*)&from, &fromLen );
+	if ( n <= 0 )
+	{
+		return 0;
+	}
+	m_rxLength = (size_t)n;
+	m_remoteIP = fromInAddr ( from.sin_addr );
+	m_remotePort = ntohs ( from.sin_port );
+	return (int)n;
+}
+
+int WiFiUDP::available ()
+{
+	return (int)( m_rxLength - m_rxPos );
+}
+
+int WiFiUDP::read ()
+{
+	return m_rxPos < m_rxLength ? m_rxBuffer [ m_rxPos++ ] : -1;
+}
+
+int WiFiUDP::read ( unsigned char* buffer, size_t len )
+{
+	size_t n = std::min ( len, m_rxLength - m_rxPos );
+	memcpy ( buffer, m_rxBuffer + m_rxPos, n );
+	m_rxPos += n;
+	return (int)n;
+}
+
+int WiFiUDP::peek ()
+{
+	return m_rxPos < m_rxLength ? m_rxBuffer [ m_rxPos ] : -1;
+}
+
+IPAddress WiFiUDP::remoteIP ()
+{
+	return m_remoteIP;
+}
+
+uint16_t WiFiUDP::remotePort ()
+{
+	return m_remotePort;
+}
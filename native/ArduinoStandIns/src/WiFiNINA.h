@@ -0,0 +1,118 @@
+#pragma once
+/*
+ * WiFiNINA.h (native stand-in)
+ *
+ * Host version of the WiFiNINA API.  The "module" is the host's own network
+ * stack: the link is reported up ASSOCIATE_MS after begin() (begin() itself
+ * waits for association only if a non-zero setTimeout() is in force, as the
+ * real library does), addresses come from the
+ * first non-loopback IPv4 interface, and WiFiServer / WiFiClient / WiFiUDP
+ * are backed by non-blocking POSIX sockets.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "IPAddress.h"
+
+#include <Arduino.h>
+
+#define WIFI_FIRMWARE_LATEST_VERSION "1.5.0"
+
+enum wl_status_t : uint8_t
+{
+	WL_NO_SHIELD = 255,
+	WL_NO_MODULE = WL_NO_SHIELD,
+	WL_IDLE_STATUS = 0,
+	WL_NO_SSID_AVAIL,
+	WL_SCAN_COMPLETED,
+	WL_CONNECTED,
+	WL_CONNECT_FAILED,
+	WL_CONNECTION_LOST,
+	WL_DISCONNECTED,
+	WL_AP_LISTENING,
+	WL_AP_CONNECTED,
+	WL_AP_FAILED
+};
+
+class WiFiClass
+{
+public:
+	const char* firmwareVersion ();
+	void setTimeout ( unsigned long timeout );
+	int begin ( const char* ssid, const char* passphrase );
+	uint8_t beginAP ( const char* ssid, const char* passphrase = nullptr );
+	int disconnect ();
+	void end ();
+	uint8_t status ();
+	void setHostname ( const char* name );
+	const char* SSID ();
+	int32_t RSSI ();
+	uint8_t* macAddress ( uint8_t* mac );
+	IPAddress localIP ();
+	IPAddress subnetMask ();
+	IPAddress gatewayIP ();
+	unsigned long getTime ();
+
+	// Host-only: forces the link state, e.g. to exercise reconnection paths.
+	void SetLinkUp ( bool bUp );
+	bool IsLinkUp () const;
+
+private:
+	static constexpr uint32_t ASSOCIATE_MS = 300;  // simulated association time after begin()
+	uint8_t m_status = WL_IDLE_STATUS;
+	bool m_bLinkUp = true;
+	bool m_bAssociating = false;
+	uint32_t m_ulBeginMs = 0;
+	unsigned long m_ulTimeoutMs = 10000;
+	char m_ssid [ 33 ] = {};
+	void QueryInterface ();
+	bool m_bQueried = false;
+	IPAddress m_localIP;
+	IPAddress m_subnetMask;
+	IPAddress m_gatewayIP;
+};
+
+extern WiFiClass WiFi;
+
+class WiFiClient : public Stream
+{
+public:
+	WiFiClient () = default;
+	explicit WiFiClient ( int fd ) : m_fd ( fd )
+	{
+	}
+	uint8_t connected ();
+	operator bool ()
+	{
+		return m_fd >= 0;
+	}
+	int available () override;
+	int read () override;
+	int peek () override;
+	size_t write ( uint8_t c ) override;
+	size_t write ( const uint8_t* buffer, size_t size ) override;
+	using Print::write;
+	void stop ();
+
+private:
+	int m_fd = -1;
+};
+
+class WiFiServer
+{
+public:
+	explicit WiFiServer ( uint16_t port ) : m_port ( port )
+	{
+	}
+	void begin ();
+	WiFiClient available ();
+
+private:
+	uint16_t m_port;
+	int m_fd = -1;
+};
+
+#include "WiFiUdp.h"
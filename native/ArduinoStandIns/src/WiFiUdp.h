@@ -0,0 +1,52 @@
+#pragma once
+/*
+ * WiFiUdp.h (native stand-in)
+ *
+ * WiFiUDP backed by a non-blocking POSIX datagram socket with SO_BROADCAST,
+ * so the service can be driven by ordinary UDP clients on the host.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "IPAddress.h"
+
+#include <Arduino.h>
+
+class WiFiUDP : public Stream
+{
+public:
+	uint8_t begin ( uint16_t port );
+	void stop ();
+	int beginPacket ( IPAddress ip, uint16_t port );
+	int endPacket ();
+	size_t write ( uint8_t c ) override;
+	size_t write ( const uint8_t* buffer, size_t size ) override;
+	using Print::write;
+	int parsePacket ();
+	int available () override;
+	int read () override;
+	int read ( unsigned char* buffer, size_t len );
+	int read ( char* buffer, size_t len )
+	{
+		return read ( (unsigned char*)buffer, len );
+	}
+	int peek () override;
+	IPAddress remoteIP ();
+	uint16_t remotePort ();
+
+private:
+	static constexpr size_t MAX_DATAGRAM = 1500;
+	int m_fd = -1;
+	uint8_t m_rxBuffer [ MAX_DATAGRAM ];
+	size_t m_rxLength = 0;
+	size_t m_rxPos = 0;
+	uint8_t m_txBuffer [ MAX_DATAGRAM ];
+	size_t m_txLength = 0;
+	IPAddress m_txIP;
+	uint16_t m_txPort = 0;
+	IPAddress m_remoteIP;
+	uint16_t m_remotePort = 0;
+};
@@ -0,0 +1,31 @@
+#pragma once
+/*
+ * Wire.h (native stand-in)
+ *
+ * I2C bus stand-in.  Every address acknowledges so the simulated BME280 in
+ * BME280I2C.h is detected as present.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include <Arduino.h>
+
+class TwoWire
+{
+public:
+	void begin ()
+	{
+	}
+	void beginTransmission ( uint8_t )
+	{
+	}
+	uint8_t endTransmission ()
+	{
+		return 0;
+	}
+};
+
+inline TwoWire Wire;
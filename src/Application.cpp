@@ -14,6 +14,7 @@
 #include "ConfigStorage.h"
 #include "Display.h"
 #include "GarageMessageProtocol.h"
+#include "Scheduler.h"
 
 #include <MNPCIHandler.h>
 #include <MNRGBLEDBaseLib.h>
@@ -54,6 +55,9 @@ Display* pMyDisplay = nullptr;
 // ─── External RGB LED ────────────────────────────────────────────────────────
 MNRGBLEDBaseLib* pMyLED = nullptr;
 
+// ─── Loop scheduler (runs the task functions registered in begin()) ───────────
+Scheduler MyScheduler;
+
 // ─── Misc globals ─────────────────────────────────────────────────────────────
 unsigned long ulLastClientReq = 0UL;
 
@@ -159,7 +163,42 @@ void Application::begin ()
 
 	pMyProtocol = new GarageMessageProtocol ( pGarageDoor, pBME280Sensor, EnvironmentResults, *pMyUDPService );
 
-	pMyDisplay = new Display ( MyLogger, pMyUDPService, VERSION, pGarageDoor, pBME280Sensor );
+	pMyDisplay = new Display ( MyLogger, pMyUDPService, VERSION, pGarageDoor, pBME280Sensor, &MyScheduler );
+
+	// Every-pass tasks first, in the order a request is best served: read it, act on
+	// the door, send what that produced. Periodic work comes last and is the part the
+	// pass budget can hold back.
+	MyScheduler.AddTask ( "udp", taskUDP, LoopStage::Udp, 0, 0, POLL_TASK_DEADLINE_MS, UDP_DRAIN_BUDGET_US );
+	MyScheduler.AddTask ( "door", taskDoor, LoopStage::Door, 0, 1, POLL_TASK_DEADLINE_MS, POLL_TASK_BUDGET_US );
+	MyScheduler.AddTask ( "sendq",
+	                      taskSendQueue,
+	                      LoopStage::SendQueue,
+	                      0,
+	                      2,
+	                      POLL_TASK_DEADLINE_MS,
+	                      POLL_TASK_BUDGET_US );
+	MyScheduler.AddTask ( "led", taskLED, LoopStage::Led, 0, 3, POLL_TASK_DEADLINE_MS, POLL_TASK_BUDGET_US );
+	MyScheduler.AddTask ( "onboard",
+	                      taskOnboarding,
+	                      LoopStage::Onboarding,
+	                      0,
+	                      4,
+	                      POLL_TASK_DEADLINE_MS,
+	                      POLL_TASK_BUDGET_US );
+	MyScheduler.AddTask ( "sensor",
+	                      taskSensor,
+	                      LoopStage::Sensor,
+	                      SENSOR_READ_INTERVAL_MS,
+	                      5,
+	                      SENSOR_READ_INTERVAL_MS,
+	                      SENSOR_TASK_BUDGET_US );
+	MyScheduler.AddTask ( "display",
+	                      taskDisplay,
+	                      LoopStage::Display,
+	                      DISPLAY_REFRESH_MS,
+	                      6,
+	                      DISPLAY_REFRESH_MS,
+	                      DISPLAY_TASK_BUDGET_US );
 }
 
 /**
@@ -285,84 +324,128 @@ void Application::setLED ()
 // ─── loop ─────────────────────────────────────────────────────────────────────
 /**
  * @brief Main execution loop called repeatedly from the Arduino loop() function.
- * @details Each call: updates the LED, processes onboarding if in AP mode,
- *          checks for incoming UDP commands, reads the BME280 sensor at
- *          SENSOR_READ_INTERVAL_MS intervals (multicasting the result), refreshes
- *          the debug display every 500 ms, and polls the garage door state machine
- *          multicasting whenever door or light state changes.
+ * @details Runs whatever scheduler tasks are due (see begin() and the task
+ *          functions below); every-pass tasks run on each call, the sensor and
+ *          display tasks at their periods. Then, unless the pass handled a UDP
+ *          request, sleeps until the next interrupt (at most one SysTick).
  */
 void Application::loop ()
 {
-	static unsigned long ulLastSensorTime = millis() - SENSOR_READ_INTERVAL_MS;
-	static unsigned long ulLastDisplayTime = 0UL;
-
-	static IGarageDoor::State LastDoorState = IGarageDoor::State::Unknown;
-	static bool LastLightState = false;
-
-	// set initial light state
-	if ( pGarageDoor != nullptr && ulLastDisplayTime == 0UL )
+	MyScheduler.RunDue();
+	// A pass that handled a request may have more waiting; otherwise there is
+	// nothing to do until the next interrupt.
+	if ( pMyUDPService->GetLastDrainCount() == 0 )
 	{
-		LastLightState = !pGarageDoor->IsLit();
+		MyScheduler.Idle();
 	}
-	// set LED — noInterrupts() prevents Flash() ISR racing against analogWrite()
-	// on the external LED's PWM registers, causing visible intensity flicker.
+}
+
+// ─── Scheduler tasks ──────────────────────────────────────────────────────────
+/**
+ * @brief Every-pass task: updates the LED.
+ * @details noInterrupts() prevents the Flash() ISR racing against analogWrite()
+ *          on the external LED's PWM registers, causing visible intensity flicker.
+ */
+void Application::taskLED ()
+{
 	noInterrupts();
 	setLED();
 	interrupts();
+}
 
-	// Process onboarding if in AP mode
+/**
+ * @brief Every-pass task: services the onboarding portal (does nothing outside AP mode).
+ */
+void Application::taskOnboarding ()
+{
 	pMyUDPService->ProcessOnboarding();
+}
 
-	// See if we have any udp requests to action
+/**
+ * @brief Every-pass task: drains and answers pending UDP requests.
+ */
+void Application::taskUDP ()
+{
 	pMyUDPService->CheckUDP();
+}
 
-	if ( pBME280Sensor != nullptr && pMyUDPService->GetState() != WiFiService::Status::AP_MODE &&
-	     millis() - ulLastSensorTime > SENSOR_READ_INTERVAL_MS )
+/**
+ * @brief Periodic task (SENSOR_READ_INTERVAL_MS): reads the BME280 and multicasts the result.
+ */
+void Application::taskSensor ()
+{
+	if ( pBME280Sensor != nullptr && pMyUDPService->GetState() != WiFiService::Status::AP_MODE )
 	{
 		if ( pBME280Sensor->Read ( EnvironmentResults ) )
 		{
 			multicastMsg ( UDPWiFiService::ReqMsgType::TEMPDATA );
 		}
-		ulLastSensorTime = millis();
 	}
+}
 
-	// update debug stats every 1/2 second
-	if ( millis() - ulLastDisplayTime > 500 )
+/**
+ * @brief Periodic task (DISPLAY_REFRESH_MS): checks for a new terminal client,
+ *        then refreshes the debug status screen.
+ */
+void Application::taskDisplay ()
+{
+#ifdef MNDEBUG
+	MyLogger.Poll();
+#endif
+	if ( pMyDisplay != nullptr )
 	{
-		ulLastDisplayTime = millis();
-		if ( pMyDisplay != nullptr )
-		{
-			pMyDisplay->DisplayStats();
-		}
+		pMyDisplay->DisplayStats();
 	}
+}
 
-	// if door state has changed, multicast news
-	if ( pGarageDoor != nullptr )
+/**
+ * @brief Every-pass task: polls the garage door state machine and multicasts
+ *        whenever the door or light state changes.
+ * @details The first run always multicasts, so listeners learn the initial state.
+ */
+void Application::taskDoor ()
+{
+	static IGarageDoor::State LastDoorState = IGarageDoor::State::Unknown;
+	static bool LastLightState = false;
+	static bool bFirstRun = true;
+
+	if ( pGarageDoor == nullptr )
 	{
-		pGarageDoor->Update();
-		if ( pGarageDoor->GetState() != LastDoorState || LastLightState != pGarageDoor->IsLit() )
-		{
-			LastDoorState = pGarageDoor->GetState();
-			LastLightState = pGarageDoor->IsLit();
-			multicastMsg ( UDPWiFiService::ReqMsgType::DOORDATA );
-		}
-		if ( pGarageDoor->IsSwitchConfigured() && pMyUDPService != nullptr )
+		return;
+	}
+	pGarageDoor->Update();
+	IGarageDoor::DoorSnapshot door = pGarageDoor->GetSnapshot();
+	if ( bFirstRun || door.state != LastDoorState || door.bLit != LastLightState )
+	{
+		bFirstRun = false;
+		LastDoorState = door.state;
+		LastLightState = door.bLit;
+		multicastMsg ( UDPWiFiService::ReqMsgType::DOORDATA );
+	}
+	if ( pGarageDoor->IsSwitchConfigured() && pMyUDPService != nullptr )
+	{
+		static uint16_t SwitchPressedCount = 0;
+		uint16_t LatestSwitchPressedCount = pGarageDoor->GetSwitchMatchCount();
+		if ( LatestSwitchPressedCount > SwitchPressedCount )
 		{
-			static uint16_t SwitchPressedCount = 0;
-			uint16_t LatestSwitchPressedCount = pGarageDoor->GetSwitchMatchCount();
-			if ( LatestSwitchPressedCount > SwitchPressedCount )
-			{
-				SwitchPressedCount = LatestSwitchPressedCount;
-			}
+			SwitchPressedCount = LatestSwitchPressedCount;
 		}
 	}
 }
 
+/**
+ * @brief Every-pass task: sends a few queued multicasts.
+ */
+void Application::taskSendQueue ()
+{
+	pMyUDPService->ProcessSendQueue();
+}
+
 // ─── processUDPMsg (static — satisfies UDPWiFiServiceCallback signature) ──────
 /**
  * @brief Static UDP message callback invoked by UDPWiFiService when a request packet arrives.
  * @details Dispatches the command to the protocol handler, builds the response
- *          string, and sends a unicast reply to the requesting client.
+ *          into a stack buffer, and sends a unicast reply to the requesting client.
  * @param eReqType The decoded request type (TEMPDATA, DOORDATA, DOOROPEN, etc.).
  */
 void Application::processUDPMsg ( UDPWiFiService::ReqMsgType eReqType )
@@ -370,10 +453,11 @@ void Application::processUDPMsg ( UDPWiFiService::ReqMsgType eReqType )
 	if ( pMyProtocol != nullptr )
 	{
 		pMyProtocol->HandleCommand ( static_cast<uint8_t> ( eReqType ) );
-		String sResponse = pMyProtocol->BuildResponse ( static_cast<uint8_t> ( eReqType ) );
-		if ( sResponse.length() > 0 )
+		char sResponse [ UDP_REPLY_MAX_LEN ];
+		size_t len = pMyProtocol->BuildResponse ( static_cast<uint8_t> ( eReqType ), sResponse, sizeof ( sResponse ) );
+		if ( len > 0 )
 		{
-			pMyUDPService->SendReply ( sResponse );
+			pMyUDPService->SendReply ( sResponse, len );
 		}
 	}
 }
@@ -389,10 +473,11 @@ void Application::multicastMsg ( UDPWiFiService::ReqMsgType eReqType )
 {
 	if ( pMyProtocol != nullptr )
 	{
-		String sResponse = pMyProtocol->BuildResponse ( static_cast<uint8_t> ( eReqType ) );
-		if ( sResponse.length() > 0 )
+		char sResponse [ UDP_RESPONSE_MAX_LEN ];
+		size_t len = pMyProtocol->BuildResponse ( static_cast<uint8_t> ( eReqType ), sResponse, sizeof ( sResponse ) );
+		if ( len > 0 )
 		{
-			pMyUDPService->SendAll ( sResponse );
+			pMyUDPService->SendAll ( sResponse, len );
 		}
 	}
 }
@@ -14,6 +14,7 @@
 #include "Display.h"
 
 #include "Logging.h"
+#include "LoopProfiler.h"
 #include "WiFiService.h"
 
 #include <WiFiNINA.h>
@@ -33,6 +34,11 @@ extern UDPWiFiService* pMyUDPService;
 
 constexpr uint8_t ERROR_LINE = 25;
 constexpr uint8_t NWPrintStartLine = 15;
+constexpr uint8_t NWMcastRows = 4;                           // multicast destinations from NWPrintStartLine, column 41
+constexpr uint8_t NWMcastHeaderLine = NWPrintStartLine - 1;  // heading over the multicast destinations
+constexpr uint8_t NWStatsStartLine = 6;                      // link, clock, drain and multicast counters, column 41
+constexpr uint8_t NWStatsRows = 8;
+static_assert ( NWStatsStartLine + NWStatsRows <= NWMcastHeaderLine, "column 41 counters run into the multicast rows" );
 
 // ─── Free function: Error ─────────────────────────────────────────────────────
 
@@ -110,22 +116,55 @@ void DisplaylastInfoErrorMsg ()
  * @param version   Firmware version string displayed in the heading row.
  * @param pDoor     Pointer to the garage door interface; may be nullptr if no door present.
  * @param pSensor   Pointer to the environment sensor interface; may be nullptr if no sensor.
+ * @param pScheduler Pointer to the loop scheduler; may be nullptr (task statistics not shown).
  */
 Display::Display ( ansiVT220Logger& logger,
                    UDPWiFiService* pUDPService,
                    const char* version,
                    IGarageDoor* pDoor,
-                   IEnvironmentSensor* pSensor )
+                   IEnvironmentSensor* pSensor,
+                   const Scheduler* pScheduler )
     : m_logger ( logger ), m_pUDPService ( pUDPService ), m_version ( version ), m_pDoor ( pDoor ),
-      m_pSensor ( pSensor )
+      m_pSensor ( pSensor ), m_pScheduler ( pScheduler ), m_ulStartMs ( millis() ),
+      m_ulLastMs ( m_ulStartMs )
 {
 }
 
+// ─── Display::TrackMillisWrap (private helper) ────────────────────────────────
+/**
+ * @brief Counts millis() wrapping round at 2^32 ms (~49.7 days), for GetUptimeMs().
+ * @details Called on every DisplayStats() call, whether or not a frame is drawn or MNDEBUG is
+ *          defined, so no wrap is missed while no client is watching.
+ */
+void Display::TrackMillisWrap ()
+{
+	uint32_t ulNow = millis();
+	if ( ulNow < m_ulLastMs )
+	{
+		m_ulMillisWraps++;
+	}
+	m_ulLastMs = ulNow;
+}
+
+// ─── Display::GetUptimeMs ─────────────────────────────────────────────────────
+/**
+ * @brief Returns the time since the Display was constructed.
+ * @details The wraps counted by TrackMillisWrap() extend millis() to 64 bits, so the uptime
+ *          carries on past ~49.7 days instead of starting again from zero. A wrap since the
+ *          last DisplayStats() call is allowed for.
+ * @return Elapsed milliseconds.
+ */
+uint64_t Display::GetUptimeMs () const
+{
+	uint32_t ulNow = millis();
+	uint32_t ulWraps = m_ulMillisWraps + ( ulNow < m_ulLastMs ? 1UL : 0UL );
+	return ( (uint64_t)ulWraps << 32 ) + ulNow - m_ulStartMs;
+}
+
 // ─── Display::DisplayUptime (private helper) ──────────────────────────────────
 /**
- * @brief Renders the elapsed run time as "DD:HH:MM:SS" at the specified terminal position.
- * @details Records the first call time and computes relative elapsed time on
- *          subsequent calls. Resets the origin when millis() wraps around at ~49 days.
+ * @brief Renders the elapsed run time (see GetUptimeMs()) as "DD:HH:MM:SS" at the specified
+ *        terminal position.
  * @param line Screen line (1-based) at which to print.
  * @param row  Screen column (1-based) at which to print.
  * @param fg   Foreground colour for the text.
@@ -133,39 +172,21 @@ Display::Display ( ansiVT220Logger& logger,
  */
 void Display::DisplayUptime ( uint8_t line, uint8_t row, ansiVT220Logger::colours fg, ansiVT220Logger::colours bg )
 {
-	static uint32_t ulStartTime = 0UL;
-	uint32_t ulNow = millis();
-
-	if ( ulStartTime == 0 )
-	{
-		ulStartTime = ulNow;
-	}
-	else
-	{
-		if ( ulNow > ulStartTime )
-		{
-			uint32_t ulTotal = ( ulNow - ulStartTime ) / 1000;
-			uint32_t ulDays = ulTotal / ( 60 * 60 * 24 );
-			uint32_t ulHours = ( ulTotal / ( 60 * 60 ) ) % 24;
-			uint32_t ulMinutes = ( ulTotal / 60 ) % 60;
-			uint32_t ulSecs = ulTotal % 60;
-
-			char sUpTime [ 20 ];
-			snprintf ( sUpTime,
-			           sizeof ( sUpTime ),
-			           "%02d:%02d:%02d:%02d",
-			           (int)ulDays,
-			           (int)ulHours,
-			           (int)ulMinutes,
-			           (int)ulSecs );
-			m_logger.COLOUR_AT ( fg, bg, line, row, sUpTime );
-		}
-		else
-		{
-			// millis() wrapped around — reset origin
-			ulStartTime = ulNow;
-		}
-	}
+	uint32_t ulTotal = (uint32_t)( GetUptimeMs() / 1000ULL );
+	uint32_t ulDays = ulTotal / ( 60 * 60 * 24 );
+	uint32_t ulHours = ( ulTotal / ( 60 * 60 ) ) % 24;
+	uint32_t ulMinutes = ( ulTotal / 60 ) % 60;
+	uint32_t ulSecs = ulTotal % 60;
+
+	char sUpTime [ 20 ];
+	snprintf ( sUpTime,
+	           sizeof ( sUpTime ),
+	           "%02d:%02d:%02d:%02d",
+	           (int)ulDays,
+	           (int)ulHours,
+	           (int)ulMinutes,
+	           (int)ulSecs );
+	m_logger.COLOUR_AT ( fg, bg, line, row, sUpTime );
 }
 
 // ─── Display::DisplayStats ────────────────────────────────────────────────────
@@ -174,11 +195,34 @@ void Display::DisplayUptime ( uint8_t line, uint8_t row, ansiVT220Logger::colour
  *        door state, network status, and the notification bar.
  * @details Compiled only when MNDEBUG is defined. Calls DisplayNWStatus() and
  *          DisplaylastInfoErrorMsg() as sub-steps. Intended to be called at
- *          approximately 2 Hz from Application::loop().
+ *          approximately 2 Hz from Application::loop(). Every field is drawn on
+ *          every frame; the logger sends only the cells that changed, once the
+ *          frame is ended. Nothing is formatted while no client is connected, and
+ *          the first frame after a client connects clears and repaints the whole
+ *          screen. A frame is skipped while the client has not yet taken all of
+ *          the previous one, so a slow client gets fewer frames rather than a
+ *          growing backlog.
  */
 void Display::DisplayStats ()
 {
+	TrackMillisWrap();
 #ifdef MNDEBUG
+	if ( !m_logger.IsClientConnected() )
+	{
+		m_bRepaintDue = true;
+		return;
+	}
+	if ( !m_logger.ReadyForFrame() )
+	{
+		m_ulSkippedFrames++;
+		return;
+	}
+	if ( m_bRepaintDue )
+	{
+		m_bRepaintDue = false;
+		m_logger.ClearScreen();
+	}
+
 	// Row 1: uptime | heading (with software version) | current time
 	DisplayUptime ( 1, 1, ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK );
 
@@ -196,20 +240,30 @@ void Display::DisplayStats ()
 	// ── Garage door section ───────────────────────────────────────────────────
 	if ( m_pDoor != nullptr )
 	{
+		IGarageDoor::DoorSnapshot door = m_pDoor->GetSnapshot();
 		m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, 4, 0, F ( "Light is " ) );
 		m_logger.ClearPartofLine ( 4, 14, 3 );
 		m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
 		                     ansiVT220Logger::BG_BLACK,
 		                     4,
 		                     14,
-		                     m_pDoor->IsLit() ? F ( "On" ) : F ( "Off" ) );
+		                     door.bLit ? F ( "On" ) : F ( "Off" ) );
 
 		m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, 5, 0, F ( "State is " ) );
 		m_logger.ClearPartofLine ( 5, 14, 8 );
-		const char* stateStr = m_pDoor->GetStateDisplayString();
-		auto stateColour =
-		    ( m_pDoor->GetState() == IGarageDoor::State::Closed ) ? ansiVT220Logger::FG_CYAN : ansiVT220Logger::FG_RED;
-		m_logger.COLOUR_AT ( stateColour, ansiVT220Logger::BG_BLACK, 5, 14, stateStr );
+		auto stateColour = door.IsClosed() ? ansiVT220Logger::FG_CYAN : ansiVT220Logger::FG_RED;
+		m_logger.COLOUR_AT ( stateColour, ansiVT220Logger::BG_BLACK, 5, 14, door.stateName );
+
+		// pin event queue: most events waiting at once, events dropped, worst wait for Update()
+		IGarageDoor::EventQueueStats events = m_pDoor->GetEventQueueStats();
+		m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, 6, 0, F ( "Events pk/drop/us: " ) );
+		m_logger.ClearPartofLine ( 6, 20, 20 );
+		m_logger.COLOUR_AT ( events.overflowCount != 0 ? ansiVT220Logger::FG_YELLOW : ansiVT220Logger::FG_CYAN,
+		                     ansiVT220Logger::BG_BLACK,
+		                     6,
+		                     20,
+		                     String ( events.peak ) + "/" + String ( events.overflowCount ) + "/" +
+		                         String ( events.maxLatencyUs ) );
 	}
 	else
 	{
@@ -249,46 +303,165 @@ void Display::DisplayStats ()
 	}
 
 	DisplayNWStatus();
+	DisplayLoopProfile();
+	DisplaySchedulerStats();
 	DisplaylastInfoErrorMsg();
+
+	// bytes the previous frame sent to the terminal, the most any frame has, and frames skipped
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, 23, 81, F ( "Frame B/max/skip: " ) );
+	m_logger.ClearPartofLine ( 23, 101, 19 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     23,
+	                     101,
+	                     String ( m_logger.GetLastFrameBytes() ) + "/" + String ( m_logger.GetMaxFrameBytes() ) + "/" +
+	                         String ( m_ulSkippedFrames ) );
+#ifdef TELNET
+	// TCP writes to the Telnet client and their average size
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, 24, 81, F ( "Telnet sends/avg: " ) );
+	m_logger.ClearPartofLine ( 24, 101, 19 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     24,
+	                     101,
+	                     String ( Telnet.GetFlushCount() ) + "/" + String ( Telnet.GetAverageFlushBytes() ) );
 #endif
+	m_logger.EndFrame();
+#endif
+}
+
+// ─── Display::DisplayLoopProfile (private helper) ─────────────────────────────
+/**
+ * @brief Shows the loop profiler's max and p99 per stage in columns 81 onwards.
+ * @details Rows 3-11: a heading, then one row per loop stage and the whole pass.
+ *          Compiled only when LOOP_PROFILER is defined.
+ */
+void Display::DisplayLoopProfile ()
+{
+#ifdef LOOP_PROFILER
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, 3, 81, F ( "Loop (us)  max/p99" ) );
+	for ( uint8_t slot = 0; slot < LoopProfiler::SLOT_COUNT; slot++ )
+	{
+		uint8_t line = 4 + slot;
+		m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+		                     ansiVT220Logger::BG_BLACK,
+		                     line,
+		                     81,
+		                     LoopProfiler::SlotName ( slot ) );
+		m_logger.ClearPartofLine ( line, 92, 17 );
+		m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+		                     ansiVT220Logger::BG_BLACK,
+		                     line,
+		                     92,
+		                     String ( theLoopProfiler.GetMaxUs ( slot ) ) + "/" +
+		                         String ( theLoopProfiler.GetPercentileUs ( slot, 99 ) ) );
+	}
+#endif
+}
+
+// ─── Display::DisplaySchedulerStats (private helper) ──────────────────────────
+/**
+ * @brief Shows each scheduler task's lateness, deadline misses, overruns and
+ *        deferrals in columns 81 onwards, followed by the idle duty cycle.
+ * @details Rows 13 onwards: a heading, then one row per task in priority order,
+ *          then the share of the last second spent awake and the time asleep.
+ */
+void Display::DisplaySchedulerStats ()
+{
+	if ( m_pScheduler == nullptr )
+	{
+		return;
+	}
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     13,
+	                     81,
+	                     F ( "Task  late(us)/miss/ovr/defer" ) );
+	for ( uint8_t i = 0; i < m_pScheduler->GetTaskCount(); i++ )
+	{
+		Scheduler::TaskStats task = m_pScheduler->GetTaskStats ( i );
+		uint8_t line = 14 + i;
+		m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, line, 81, task.name );
+		m_logger.ClearPartofLine ( line, 92, 28 );
+		m_logger.COLOUR_AT ( task.missed != 0 || task.overruns != 0 ? ansiVT220Logger::FG_YELLOW
+		                                                              : ansiVT220Logger::FG_CYAN,
+		                     ansiVT220Logger::BG_BLACK,
+		                     line,
+		                     92,
+		                     String ( task.maxLateUs ) + "/" + String ( task.missed ) + "/" + String ( task.overruns ) +
+		                         "/" + String ( task.deferrals ) );
+	}
+
+	uint8_t line = 15 + m_pScheduler->GetTaskCount();
+	uint16_t awake = m_pScheduler->GetAwakePermille();
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, line, 81, F ( "Awake %/asleep(s): " ) );
+	m_logger.ClearPartofLine ( line, 101, 19 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     line,
+	                     101,
+	                     String ( awake / 10 ) + "." + String ( awake % 10 ) + "/" +
+	                         String ( m_pScheduler->GetTotalSleepMs() / 1000UL ) );
 }
 
 // ─── Display::DisplayNWStatus ─────────────────────────────────────────────────
 /**
  * @brief Renders the network status panel: SSID, hostname, IP address, subnet mask,
- *        multicast destination list, gateway, MAC address, signal strength,
+ *        multicast destinations and their send health, gateway, MAC address, signal strength,
  *        WiFi connection counters, and message statistics.
- * @details Does nothing if m_pUDPService is nullptr. Called by DisplayStats().
+ * @details Does nothing if m_pUDPService is nullptr. Called by DisplayStats(). The
+ *          network details come from the service's network-info snapshot, so the
+ *          panel makes no NINA SPI calls.
  */
 void Display::DisplayNWStatus ()
 {
-	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, NWPrintStartLine, 0, F ( "SSID: " ) );
-	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN, ansiVT220Logger::BG_BLACK, NWPrintStartLine, 23, WiFi.SSID() );
-
 	if ( m_pUDPService == nullptr )
 	{
 		return;
 	}
+	const WiFiService::NetworkInfo& net = m_pUDPService->GetNetworkInfo();
 
-	FixedIPList* pMulticastDestList = m_pUDPService->GetMulticastList();
-	if ( pMulticastDestList != nullptr )
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, NWPrintStartLine, 0, F ( "SSID: " ) );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN, ansiVT220Logger::BG_BLACK, NWPrintStartLine, 23, net.ssid );
+
+	// one row per destination with its send health, yellow while it is failing; rows left over
+	// by an expired subnet are blanked
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWMcastHeaderLine,
+	                     41,
+	                     F ( "Mcast dest         sent/fail/max us" ) );
+	const UDPWiFiService::MulticastDestSet& multicastDests = m_pUDPService->GetMulticastList();
+	uint8_t iterator = multicastDests.GetUncountedIterator();
+	uint8_t row = 0;
+	IPAddress mcastDest;
+	while ( row < NWMcastRows &&
+	        ( mcastDest = multicastDests.GetNext ( iterator ) ) != IPAddress ( (uint32_t)0 ) )
 	{
-		uint8_t iterator = pMulticastDestList->GetIterator();
-		IPAddress mcastDest;
-		while ( ( mcastDest = pMulticastDestList->GetNext ( iterator ) ) != IPAddress ( (uint32_t)0 ) )
-		{
-			m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
-			                     ansiVT220Logger::BG_BLACK,
-			                     NWPrintStartLine + iterator - 1,
-			                     41,
-			                     "Mcast #" + String ( iterator ) + ": " );
-			m_logger.ClearPartofLine ( NWPrintStartLine + iterator - 1, 61, 15 );
-			m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
-			                     ansiVT220Logger::BG_BLACK,
-			                     NWPrintStartLine + iterator - 1,
-			                     61,
-			                     m_pUDPService->ToIPString ( mcastDest ) );
-		}
+		const UDPWiFiService::DestHealth* pHealth = multicastDests.GetValue ( mcastDest );
+		m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+		                     ansiVT220Logger::BG_BLACK,
+		                     NWPrintStartLine + row,
+		                     41,
+		                     "#" + String ( row + 1 ) + " " );
+		m_logger.ClearPartofLine ( NWPrintStartLine + row, 44, 36 );
+		m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+		                     ansiVT220Logger::BG_BLACK,
+		                     NWPrintStartLine + row,
+		                     44,
+		                     m_pUDPService->ToIPString ( mcastDest ) );
+		m_logger.COLOUR_AT ( pHealth->consecutiveFailures != 0 ? ansiVT220Logger::FG_YELLOW
+		                                                       : ansiVT220Logger::FG_CYAN,
+		                     ansiVT220Logger::BG_BLACK,
+		                     NWPrintStartLine + row,
+		                     60,
+		                     String ( pHealth->sent ) + "/" + String ( pHealth->failed ) + "/" +
+		                         String ( pHealth->maxSendUs ) );
+		row++;
+	}
+	for ( ; row < NWMcastRows; row++ )
+	{
+		m_logger.ClearPartofLine ( NWPrintStartLine + row, 41, 39 );
 	}
 
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
@@ -311,7 +484,7 @@ void Display::DisplayNWStatus ()
 	                     ansiVT220Logger::BG_BLACK,
 	                     NWPrintStartLine + 2,
 	                     23,
-	                     m_pUDPService->ToIPString ( WiFi.localIP() ) );
+	                     m_pUDPService->ToIPString ( net.localIP ) );
 
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
 	                     ansiVT220Logger::BG_BLACK,
@@ -322,7 +495,7 @@ void Display::DisplayNWStatus ()
 	                     ansiVT220Logger::BG_BLACK,
 	                     NWPrintStartLine + 3,
 	                     23,
-	                     m_pUDPService->ToIPString ( WiFi.subnetMask() ) );
+	                     m_pUDPService->ToIPString ( net.subnetMask ) );
 
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
 	                     ansiVT220Logger::BG_BLACK,
@@ -386,8 +559,7 @@ void Display::DisplayNWStatus ()
 	                     NWPrintStartLine + 5,
 	                     0,
 	                     F ( "Mac address: " ) );
-	byte bMac [ 6 ] = { 0 };
-	WiFi.macAddress ( bMac );
+	const uint8_t* bMac = net.mac;
 	char s [ 18 ];
 	snprintf ( s,
 	           sizeof ( s ),
@@ -409,7 +581,7 @@ void Display::DisplayNWStatus ()
 	                     ansiVT220Logger::BG_BLACK,
 	                     NWPrintStartLine + 6,
 	                     23,
-	                     m_pUDPService->ToIPString ( WiFi.gatewayIP() ) );
+	                     m_pUDPService->ToIPString ( net.gatewayIP ) );
 
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
 	                     ansiVT220Logger::BG_BLACK,
@@ -420,7 +592,7 @@ void Display::DisplayNWStatus ()
 	                     ansiVT220Logger::BG_BLACK,
 	                     NWPrintStartLine + 7,
 	                     23,
-	                     String ( WiFi.RSSI() ) );
+	                     String ( net.rssi ) );
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE, ansiVT220Logger::BG_BLACK, NWPrintStartLine + 7, 30, F ( " dBm" ) );
 
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
@@ -433,7 +605,7 @@ void Display::DisplayNWStatus ()
 	                     ansiVT220Logger::BG_BLACK,
 	                     NWPrintStartLine + 8,
 	                     23,
-	                     m_pUDPService->WiFiStatusToString ( WiFi.status() ) );
+	                     m_pUDPService->WiFiStatusToString ( net.status ) );
 
 	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
 	                     ansiVT220Logger::BG_BLACK,
@@ -445,4 +617,137 @@ void Display::DisplayNWStatus ()
 	                     NWPrintStartLine + 8,
 	                     61,
 	                     String ( m_pUDPService->GetState() ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWPrintStartLine + 9,
+	                     0,
+	                     F ( "Reply latency (us): " ) );
+	m_logger.ClearPartofLine ( NWPrintStartLine + 9, 23, 17 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWPrintStartLine + 9,
+	                     23,
+	                     String ( m_pUDPService->GetLastReplyLatencyUs() ) + "/" +
+	                         String ( m_pUDPService->GetMaxReplyLatencyUs() ) );
+
+	const OutboundPacketQueue& sendQueue = m_pUDPService->GetSendQueue();
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWPrintStartLine + 9,
+	                     41,
+	                     F ( "Send q/peak/drop: " ) );
+	m_logger.ClearPartofLine ( NWPrintStartLine + 9, 61, 15 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWPrintStartLine + 9,
+	                     61,
+	                     String ( sendQueue.Count() ) + "/" + String ( sendQueue.GetHighWaterMark() ) + "/" +
+	                         String ( sendQueue.GetDroppedCount() ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine,
+	                     41,
+	                     F ( "Link state (s): " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine, 61, 20 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine,
+	                     61,
+	                     String ( WiFiService::LinkStateToString ( m_pUDPService->GetLinkState() ) ) + " " +
+	                         String ( m_pUDPService->GetTimeInLinkState() / 1000 ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 1,
+	                     41,
+	                     F ( "Up/wait/conn (s): " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 1, 61, 20 );
+	m_logger.COLOUR_AT (
+	    ansiVT220Logger::FG_CYAN,
+	    ansiVT220Logger::BG_BLACK,
+	    NWStatsStartLine + 1,
+	    61,
+	    String ( m_pUDPService->GetTotalTimeInLinkState ( WiFiService::LinkState::CONNECTED ) / 1000 ) + "/" +
+	        String ( m_pUDPService->GetTotalTimeInLinkState ( WiFiService::LinkState::WAITING ) / 1000 ) + "/" +
+	        String ( m_pUDPService->GetTotalTimeInLinkState ( WiFiService::LinkState::CONNECTING ) / 1000 ) );
+
+	const WallClock& clock = m_pUDPService->GetClock();
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 2,
+	                     41,
+	                     F ( "Clock syncs/ppm: " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 2, 61, 15 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 2,
+	                     61,
+	                     String ( clock.GetSyncCount() ) + "/" + String ( clock.GetDriftPpm() ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 3,
+	                     41,
+	                     F ( "Clock adj/next(m): " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 3, 61, 15 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 3,
+	                     61,
+	                     String ( clock.GetLastCorrectionMs() ) + "/" +
+	                         String ( clock.GetResyncIntervalMs() / 60000UL ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 4,
+	                     41,
+	                     F ( "UDP drain last/max: " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 4, 61, 10 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 4,
+	                     61,
+	                     String ( m_pUDPService->GetLastDrainCount() ) + "/" +
+	                         String ( m_pUDPService->GetMaxDrainCount() ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 5,
+	                     41,
+	                     F ( "Drain limit/budget: " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 5, 61, 15 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 5,
+	                     61,
+	                     String ( m_pUDPService->GetDrainLimitReachedCount() ) + "/" +
+	                         String ( m_pUDPService->GetDrainBudgetExhaustedCount() ) );
+
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 6,
+	                     41,
+	                     F ( "Mcast ops/min/exp: " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 6, 61, 20 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 6,
+	                     61,
+	                     String ( m_pUDPService->GetDestListOpsPerMinute() ) + "/" +
+	                         String ( m_pUDPService->GetMulticastList().GetExpiredCount() ) );
+
+	// failed multicasts that found every destination failing and so restarted the link
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_WHITE,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 7,
+	                     41,
+	                     F ( "Mcast link drops: " ) );
+	m_logger.ClearPartofLine ( NWStatsStartLine + 7, 61, 20 );
+	m_logger.COLOUR_AT ( ansiVT220Logger::FG_CYAN,
+	                     ansiVT220Logger::BG_BLACK,
+	                     NWStatsStartLine + 7,
+	                     61,
+	                     String ( m_pUDPService->GetDestEscalationCount() ) );
 }
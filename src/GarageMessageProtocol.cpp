@@ -8,12 +8,25 @@
  *
  * History:
  *   Ver 1.0   Phase 6 — initial implementation
+ *   Ver 1.1   BuildResponse writes into a caller buffer with fixed-point formatting
+ *   Ver 1.2   Versioned payload cache for TEMPDATA and DOORDATA
+ *   Ver 1.3   DOORDATA rendered from one IGarageDoor::GetSnapshot()
+ *   Ver 1.4   STATS reply with the loop profile
+ *   Ver 1.5   STATS reply carries the door event queue counters
  */
 
 #include "GarageMessageProtocol.h"
 
+#include "LoopProfiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
 extern void Error ( String s, bool bInISR = false );
 
+static_assert ( UDPWiFiService::ReqMsgType::TEMPDATA == 0 && UDPWiFiService::ReqMsgType::DOORDATA == 1,
+                "m_cache is indexed by the data request types" );
+
 // ─── Constructor ─────────────────────────────────────────────────────────────
 /**
  * @brief Constructs the protocol handler,
@@ -31,70 +44,360 @@ GarageMessageProtocol::GarageMessageProtocol ( IGarageDoor* pDoor,
 {
 }
 
+// ─── Response formatting helpers ─────────────────────────────────────────────
+// Each helper appends to [p, pEnd) and advances p, returning false (and leaving p
+// unchanged) if the text would not fit. pEnd leaves room for the terminating null.
+
+/**
+ * @brief Appends a null-terminated string.
+ * @param p    Write position; advanced past the appended text.
+ * @param pEnd One past the last usable character.
+ * @param pStr Text to append.
+ * @return true if the text fitted.
+ */
+static bool AppendStr ( char*& p, const char* pEnd, const char* pStr )
+{
+	size_t len = strlen ( pStr );
+	if ( len > (size_t)( pEnd - p ) )
+	{
+		return false;
+	}
+	memcpy ( p, pStr, len );
+	p += len;
+	return true;
+}
+
+/**
+ * @brief Appends an unsigned integer in decimal, using integer arithmetic only.
+ * @param p     Write position; advanced past the appended digits.
+ * @param pEnd  One past the last usable character.
+ * @param value Value to append.
+ * @param minDigits Pad with leading zeros to at least this many digits.
+ * @return true if the digits fitted.
+ */
+static bool AppendUInt ( char*& p, const char* pEnd, uint32_t value, uint8_t minDigits = 1 )
+{
+	char digits [ 10 ];
+	uint8_t count = 0;
+	do
+	{
+		digits [ count++ ] = (char)( '0' + value % 10 );
+		value /= 10;
+	} while ( value != 0 || count < minDigits );
+
+	if ( count > pEnd - p )
+	{
+		return false;
+	}
+	while ( count > 0 )
+	{
+		*p++ = digits [ --count ];
+	}
+	return true;
+}
+
+/**
+ * @brief Appends a reading with two decimal places, matching String ( float ) output.
+ * @details The Cortex-M0+ has no FPU, so the float is not used as a number at all: its bits
+ *          are split into the 24 bit mantissa and the binary exponent, and the value in
+ *          hundredths is worked out and rounded half to even (as printf does) in integer
+ *          arithmetic. That is exact, so the digits are the same as String ( float ) gives.
+ *          nan and inf are written as String would (" nan", " inf", "-inf"); magnitudes
+ *          too large for a uint32_t count of hundredths fall back to snprintf().
+ * @param p     Write position; advanced past the appended text.
+ * @param pEnd  One past the last usable character.
+ * @param value Reading to append.
+ * @return true if the text fitted.
+ */
+static bool AppendFixed2 ( char*& p, const char* pEnd, float value )
+{
+	constexpr uint32_t FLOAT_EXP_MASK = 0x7F800000UL;
+	constexpr uint32_t FLOAT_MANT_MASK = 0x007FFFFFUL;
+	constexpr uint32_t FIXED2_MAX_BITS = 0x4B989680UL;  // 20000000.0f; 100 times it still fits a uint32_t
+
+	uint32_t bits;
+	memcpy ( &bits, &value, sizeof ( bits ) );
+	bool bNegative = ( bits & 0x80000000UL ) != 0;
+	uint32_t magnitudeBits = bits & ~0x80000000UL;
+	if ( ( magnitudeBits & FLOAT_EXP_MASK ) == FLOAT_EXP_MASK )
+	{
+		if ( ( magnitudeBits & FLOAT_MANT_MASK ) != 0 )
+		{
+			return AppendStr ( p, pEnd, " nan" );
+		}
+		return AppendStr ( p, pEnd, bNegative ? "-inf" : " inf" );
+	}
+	if ( magnitudeBits >= FIXED2_MAX_BITS )
+	{
+		int len = snprintf ( p, pEnd - p + 1, "%.2f", (double)value );
+		if ( len < 0 || len > pEnd - p )
+		{
+			return false;
+		}
+		p += len;
+		return true;
+	}
+
+	// magnitude = mantissa * 2^exponent; denormals have no implicit leading bit
+	uint32_t biasedExp = magnitudeBits >> 23;
+	uint32_t mantissa = magnitudeBits & FLOAT_MANT_MASK;
+	int32_t exponent = -149;
+	if ( biasedExp != 0 )
+	{
+		mantissa |= 0x00800000UL;
+		exponent = (int32_t)biasedExp - 150;
+	}
+	uint32_t scaled = mantissa * 100UL;  // below 2^31
+	uint32_t hundredths;
+	if ( exponent >= 0 )
+	{
+		hundredths = scaled << exponent;  // exact; the range check keeps it within a uint32_t
+	}
+	else if ( exponent < -32 )
+	{
+		hundredths = 0;  // scaled / 2^33 is below a quarter
+	}
+	else
+	{
+		uint8_t shift = (uint8_t)-exponent;
+		uint64_t remainder = (uint64_t)scaled & ( ( 1ULL << shift ) - 1 );
+		uint64_t half = 1ULL << ( shift - 1 );
+		hundredths = (uint32_t)( (uint64_t)scaled >> shift );
+		if ( remainder > half || ( remainder == half && ( hundredths & 1U ) != 0 ) )
+		{
+			hundredths++;
+		}
+	}
+	char* pStart = p;
+	if ( ( bNegative && !AppendStr ( p, pEnd, "-" ) ) || !AppendUInt ( p, pEnd, hundredths / 100 ) ||
+	     !AppendStr ( p, pEnd, "." ) || !AppendUInt ( p, pEnd, hundredths % 100, 2 ) )
+	{
+		p = pStart;
+		return false;
+	}
+	return true;
+}
+
 // ─── BuildResponse ───────────────────────────────────────────────────────────
 /**
- * @brief Builds the UDP response payload string for the given message type.
+ * @brief Builds the UDP response payload for the given message type into a caller buffer.
  * @details TEMPDATA responses contain comma-separated key=value pairs for
  *          temperature, humidity, dew-point, pressure, and timestamp.
  *          DOORDATA responses contain door state, light state, open/closed/moving
- *          flags, and timestamp. Command-only types (DOOROPEN etc.) produce an
- *          empty string - no response is sent.
- * @param msgType Numeric value of a UDPWiFiService::ReqMsgType enum.
- * @return The formatted response string, or an empty String if no payload applies.
+ *          flags, and timestamp. STATS responses carry the loop profile (see
+ *          BuildStatsResponse()). Command-only types (DOOROPEN etc.) produce no
+ *          payload - no response is sent. Nothing is allocated on the heap.
+ *
+ *          Everything before the timestamp is served from a per-type cache that is
+ *          re-rendered only when the state version for that type has moved on (see
+ *          RefreshStateVersion()); the A= value is appended on every call.
+ * @param msgType    Numeric value of a UDPWiFiService::ReqMsgType enum.
+ * @param pBuffer    Destination for the null-terminated payload.
+ * @param bufferSize Size of pBuffer in bytes, including room for the terminator.
+ * @return Length of the payload, or 0 if no payload applies or it did not fit.
  */
-String GarageMessageProtocol::BuildResponse ( uint8_t msgType )
+size_t GarageMessageProtocol::BuildResponse ( uint8_t msgType, char* pBuffer, size_t bufferSize )
 {
-	String sResponse;
+	if ( bufferSize == 0 )
+	{
+		return 0;
+	}
+	*pBuffer = 0;
 
 	switch ( static_cast<UDPWiFiService::ReqMsgType> ( msgType ) )
 	{
 		case UDPWiFiService::ReqMsgType::TEMPDATA:
-			if ( m_pSensor != nullptr && m_reading.valid )
+			if ( m_pSensor == nullptr || !m_reading.valid )
 			{
-				sResponse = F ( "T=" );
-				sResponse += m_reading.temperature;
-				sResponse += F ( ",H=" );
-				sResponse += m_reading.humidity;
-				sResponse += F ( ",D=" );
-				sResponse += m_reading.dewpoint;
-				sResponse += F ( ",P=" );
-				sResponse += m_reading.pressure;
-				sResponse += F ( ",A=" );
-				sResponse += m_service.GetTime();
-				sResponse += F ( "\r" );
+				return 0;
 			}
 			break;
 
 		case UDPWiFiService::ReqMsgType::DOORDATA:
-			if ( m_pDoor != nullptr )
-			{
-				sResponse = F ( "S=" );
-				sResponse += m_pDoor->GetStateDisplayString();
-				sResponse += F ( ",L=" );
-				sResponse += m_pDoor->IsLit() ? F ( "On" ) : F ( "Off" );
-				sResponse += F ( ",C=" );
-				sResponse += m_pDoor->IsClosed() ? F ( "Y" ) : F ( "N" );
-				sResponse += F ( ",O=" );
-				sResponse += m_pDoor->IsOpen() ? F ( "Y" ) : F ( "N" );
-				sResponse += F ( ",M=" );
-				sResponse += m_pDoor->IsMoving() ? F ( "Y" ) : F ( "N" );
-				sResponse += F ( ",A=" );
-				sResponse += m_service.GetTime();
-				sResponse += F ( "\r" );
-			}
-			else
+			if ( m_pDoor == nullptr )
 			{
 				Error ( F ( "Door data unavailable: pGarageDoor is null" ) );
+				return 0;
 			}
 			break;
 
+		case UDPWiFiService::ReqMsgType::STATS:
+			return BuildStatsResponse ( pBuffer, bufferSize );
+
 		default:
 			// Command-only messages (DOOROPEN, DOORCLOSE, DOORSTOP, LIGHTON, LIGHTOFF)
 			// produce no response payload.
-			break;
+			return 0;
+	}
+
+	CachedPayload& cache = m_cache [ msgType ];
+	uint32_t version = RefreshStateVersion ( msgType );
+	if ( cache.bValid && cache.version == version )
+	{
+		m_ulCacheHits++;
+	}
+	else
+	{
+		m_ulCacheMisses++;
+		cache.bValid = RenderBody ( msgType, cache );
+		cache.version = version;
+	}
+
+	char* p = pBuffer;
+	const char* pEnd = pBuffer + bufferSize - 1;
+	if ( !cache.bValid || cache.length > (size_t)( pEnd - p ) )
+	{
+		Error ( F ( "Response too long for buffer" ) );
+		return 0;
+	}
+	memcpy ( p, cache.body, cache.length );
+	p += cache.length;
+	if ( !AppendUInt ( p, pEnd, (uint32_t)m_service.GetTime() ) || !AppendStr ( p, pEnd, "\r" ) )
+	{
+		Error ( F ( "Response too long for buffer" ) );
+		p = pBuffer;
+	}
+	*p = 0;
+	return (size_t)( p - pBuffer );
+}
+
+// ─── BuildStatsResponse ──────────────────────────────────────────────────────
+/**
+ * @brief Builds the STATS (M009) reply from the loop profiler.
+ * @details One "name=max/p99" pair per loop stage and for the whole pass, in
+ *          microseconds, then, with a door, its pin event queue as evq=peak/overflows
+ *          and evlat= (worst ISR-to-Update() wait in microseconds), then N= (passes
+ *          profiled) and the A= timestamp, e.g.
+ *          "led=4/7,onboard=1/1,udp=310/511,...,pass=1210/2047,evq=2/0,evlat=1830,N=86400,A=1791000000\r".
+ *          The reply is never cached or multicast, so it is not bound by
+ *          UDP_RESPONSE_MAX_LEN. Without LOOP_PROFILER there is nothing to report
+ *          and no reply is sent.
+ * @param pBuffer    Destination for the null-terminated payload.
+ * @param bufferSize Size of pBuffer in bytes, including room for the terminator.
+ * @return Length of the payload, or 0 if profiling is compiled out or it did not fit.
+ */
+size_t GarageMessageProtocol::BuildStatsResponse ( char* pBuffer, size_t bufferSize )
+{
+#ifdef LOOP_PROFILER
+	char* p = pBuffer;
+	const char* pEnd = pBuffer + bufferSize - 1;
+	bool bFits = true;
+	for ( uint8_t slot = 0; slot < LoopProfiler::SLOT_COUNT && bFits; slot++ )
+	{
+		bFits = AppendStr ( p, pEnd, LoopProfiler::SlotName ( slot ) ) && AppendStr ( p, pEnd, "=" ) &&
+		        AppendUInt ( p, pEnd, theLoopProfiler.GetMaxUs ( slot ) ) && AppendStr ( p, pEnd, "/" ) &&
+		        AppendUInt ( p, pEnd, theLoopProfiler.GetPercentileUs ( slot, 99 ) ) && AppendStr ( p, pEnd, "," );
+	}
+	if ( m_pDoor != nullptr )
+	{
+		IGarageDoor::EventQueueStats events = m_pDoor->GetEventQueueStats();
+		bFits = bFits && AppendStr ( p, pEnd, "evq=" ) && AppendUInt ( p, pEnd, events.peak ) &&
+		        AppendStr ( p, pEnd, "/" ) && AppendUInt ( p, pEnd, events.overflowCount ) &&
+		        AppendStr ( p, pEnd, ",evlat=" ) && AppendUInt ( p, pEnd, events.maxLatencyUs ) &&
+		        AppendStr ( p, pEnd, "," );
+	}
+	bFits = bFits && AppendStr ( p, pEnd, "N=" ) && AppendUInt ( p, pEnd, theLoopProfiler.GetPassCount() ) &&
+	        AppendStr ( p, pEnd, ",A=" ) && AppendUInt ( p, pEnd, (uint32_t)m_service.GetTime() ) &&
+	        AppendStr ( p, pEnd, "\r" );
+	if ( !bFits )
+	{
+		Error ( F ( "Response too long for buffer" ) );
+		p = pBuffer;
+	}
+	*p = 0;
+	return (size_t)( p - pBuffer );
+#else
+	(void)bufferSize;
+	*pBuffer = 0;
+	return 0;
+#endif
+}
+
+// ─── Response cache ──────────────────────────────────────────────────────────
+/**
+ * @brief Advances the state version for a cached message type if its source data has changed.
+ * @details DOORDATA is rendered from a single IGarageDoor::GetSnapshot(), so every field in one
+ *          payload describes the same instant; the version moves on only when the snapshot's
+ *          state or light differs from the one last seen (open/closed/moving derive from the
+ *          state). TEMPDATA depends on the four reading values; a new sensor read that yields the
+ *          same values does not invalidate the cache.
+ * @param msgType TEMPDATA or DOORDATA.
+ * @return The current state version for msgType.
+ */
+uint32_t GarageMessageProtocol::RefreshStateVersion ( uint8_t msgType )
+{
+	CachedPayload& cache = m_cache [ msgType ];
+	if ( msgType == UDPWiFiService::ReqMsgType::DOORDATA )
+	{
+		IGarageDoor::DoorSnapshot snapshot = m_pDoor->GetSnapshot();
+		if ( snapshot.state != m_doorSnapshot.state || snapshot.bLit != m_doorSnapshot.bLit )
+		{
+			cache.stateVersion++;
+		}
+		m_doorSnapshot = snapshot;
 	}
+	else
+	{
+		const float values [] = { m_reading.temperature, m_reading.humidity, m_reading.dewpoint, m_reading.pressure };
+		if ( memcmp ( values, m_lastReadingValues, sizeof ( values ) ) != 0 )
+		{
+			memcpy ( m_lastReadingValues, values, sizeof ( values ) );
+			cache.stateVersion++;
+		}
+	}
+	return cache.stateVersion;
+}
 
-	return sResponse;
+/**
+ * @brief Renders the timestamp-independent part of a payload, up to and including "A=".
+ * @param msgType TEMPDATA or DOORDATA.
+ * @param cache   Cache entry to render into.
+ * @return true if the body fitted in the cache entry.
+ */
+bool GarageMessageProtocol::RenderBody ( uint8_t msgType, CachedPayload& cache )
+{
+	char* p = cache.body;
+	const char* pEnd = cache.body + sizeof ( cache.body );
+	bool bFits;
+
+	if ( msgType == UDPWiFiService::ReqMsgType::DOORDATA )
+	{
+		const IGarageDoor::DoorSnapshot& door = m_doorSnapshot;
+		bFits = AppendStr ( p, pEnd, "S=" ) && AppendStr ( p, pEnd, door.stateName ) && AppendStr ( p, pEnd, ",L=" ) &&
+		        AppendStr ( p, pEnd, door.bLit ? "On" : "Off" ) && AppendStr ( p, pEnd, ",C=" ) &&
+		        AppendStr ( p, pEnd, door.IsClosed() ? "Y" : "N" ) && AppendStr ( p, pEnd, ",O=" ) &&
+		        AppendStr ( p, pEnd, door.IsOpen() ? "Y" : "N" ) && AppendStr ( p, pEnd, ",M=" ) &&
+		        AppendStr ( p, pEnd, door.IsMoving() ? "Y" : "N" ) &&
+		        AppendStr ( p, pEnd, ",A=" );
+	}
+	else
+	{
+		bFits = AppendStr ( p, pEnd, "T=" ) && AppendFixed2 ( p, pEnd, m_reading.temperature ) &&
+		        AppendStr ( p, pEnd, ",H=" ) && AppendFixed2 ( p, pEnd, m_reading.humidity ) &&
+		        AppendStr ( p, pEnd, ",D=" ) && AppendFixed2 ( p, pEnd, m_reading.dewpoint ) &&
+		        AppendStr ( p, pEnd, ",P=" ) && AppendFixed2 ( p, pEnd, m_reading.pressure ) &&
+		        AppendStr ( p, pEnd, ",A=" );
+	}
+	cache.length = bFits ? (uint8_t)( p - cache.body ) : 0;
+	return bFits;
+}
+
+/**
+ * @brief Returns how many responses were served from the payload cache.
+ * @return Cache hits since boot.
+ */
+uint32_t GarageMessageProtocol::GetCacheHits () const
+{
+	return m_ulCacheHits;
+}
+
+/**
+ * @brief Returns how many responses needed the payload to be re-rendered.
+ * @return Cache misses since boot (including the first build of each type).
+ */
+uint32_t GarageMessageProtocol::GetCacheMisses () const
+{
+	return m_ulCacheMisses;
 }
 
 // ─── HandleCommand ───────────────────────────────────────────────────────────
@@ -146,7 +449,7 @@ void GarageMessageProtocol::HandleCommand ( uint8_t msgType )
 			break;
 
 		default:
-			// TEMPDATA, DOORDATA — data-request messages; no side-effect to execute.
+			// TEMPDATA, DOORDATA, STATS — data-request messages; no side-effect to execute.
 			break;
 	}
 }
@@ -18,6 +18,9 @@
  * History:
  *   Ver 1.0   Initial version (as DoorState.cpp)
  *   Ver 2.0   Phase 4 — renamed/refactored, implements IGarageDoor
+ *   Ver 2.1   GetSnapshot(); Direction moved to IGarageDoor
+ *   Ver 2.2   Pin events queued by the ISR and dispatched from Update()
+ *   Ver 2.3   Event queue counters exposed through IGarageDoor::GetEventQueueStats()
  */
 
 #define CALL_MEMBER_FN( object, ptrToMember ) ( ( object )->*( ptrToMember ) )
@@ -38,6 +41,11 @@ constexpr PinStatus UAP_TRUE = PinStatus::HIGH;
 static const char* StateNames [] = { "Opened", "Opening", "Closed", "Closing", "Stopped", "Unknown", "Bad" };
 static const char* DirectionNames [] = { "Up", "Down", "Stationary" };
 
+static const char* StateName ( IGarageDoor::State state )
+{
+	return StateNames [ (uint8_t)state % ( sizeof ( StateNames ) / sizeof ( StateNames [ 0 ] ) ) ];
+}
+
 static String onOff ( bool state )
 {
 	return state ? F ( "On" ) : F ( "Off" );
@@ -133,12 +141,24 @@ bool HormannUAP1::IsPresent () const
 }
 
 /**
- * @brief Polls the current hardware pin states and updates the door state machine.
- * @details Must be called regularly from the main loop. Reads both open and closed
- *          status pins and resolves any transition that the ISR may have missed.
+ * @brief Dispatches queued pin events, then polls the pin states to update the door state machine.
+ * @details Must be called regularly from the main loop. Events queued by the status pin ISRs
+ *          are run through the state table here, in loop context, so handlers may log, use
+ *          the heap and touch MNTimerLib. The open and closed status pins are then read to
+ *          resolve any transition that the ISR may have missed.
  */
 void HormannUAP1::Update ()
 {
+	IsrEventQueue<Event, DOOR_EVENT_QUEUE_SIZE>::Entry entry;
+	while ( m_events.Pop ( entry ) )
+	{
+		uint32_t latencyUs = micros() - entry.timestampUs;
+		if ( latencyUs > m_ulMaxEventLatencyUs )
+		{
+			m_ulMaxEventLatencyUs = latencyUs;
+		}
+		DoEvent ( entry.event );
+	}
 	if ( m_pDoorStatus != nullptr )
 	{
 		m_pDoorStatus->UpdateStatus();
@@ -210,7 +230,55 @@ bool HormannUAP1::IsLit () const
  */
 const char* HormannUAP1::GetStateDisplayString () const
 {
-	return StateNames [ (uint8_t)GetState() % ( sizeof ( StateNames ) / sizeof ( StateNames [ 0 ] ) ) ];
+	return StateName ( GetState() );
+}
+
+/**
+ * @brief Captures the door state, light, direction and counters in one consistent read.
+ * @details The status pin ISRs update these fields, so they are read with interrupts masked.
+ *          PRIMASK is saved and restored rather than unconditionally re-enabled, so this is
+ *          safe to call from code that has already disabled interrupts.
+ * @return Snapshot whose fields all describe the same instant.
+ */
+IGarageDoor::DoorSnapshot HormannUAP1::GetSnapshot () const
+{
+	DoorSnapshot snapshot;
+
+	uint32_t priMask = __get_PRIMASK();
+	__disable_irq();
+	snapshot.state = GetDoorStateInternal();
+	snapshot.direction = GetDoorDirection();
+	snapshot.bLit = m_pDoorLightStatusPin->IsMatched();
+	snapshot.openedCount = m_pDoorOpenStatusPin->GetMatchedCount();
+	snapshot.closedCount = m_pDoorClosedStatusPin->GetMatchedCount();
+	snapshot.lightOnCount = m_pDoorLightStatusPin->GetMatchedCount();
+	snapshot.lightOffCount = m_pDoorLightStatusPin->GetUnmatchedCount();
+	snapshot.sequence = ( m_pDoorStatus != nullptr ? m_pDoorStatus->GetChangeCount() : 0UL ) +
+	                    snapshot.lightOnCount + snapshot.lightOffCount;
+	__set_PRIMASK ( priMask );
+
+	snapshot.stateName = StateName ( snapshot.state );
+	return snapshot;
+}
+
+/**
+ * @brief Returns the overflow count, high-water mark and worst dispatch latency of the pin event queue.
+ * @details The ISRs update the queue counters, so they are read with interrupts masked, as in
+ *          GetSnapshot(). A non-zero overflow count means Update() is not called often enough.
+ * @return Counters since boot; the peak is out of DOOR_EVENT_QUEUE_SIZE.
+ */
+IGarageDoor::EventQueueStats HormannUAP1::GetEventQueueStats () const
+{
+	EventQueueStats stats;
+
+	uint32_t priMask = __get_PRIMASK();
+	__disable_irq();
+	stats.overflowCount = m_events.GetOverflowCount();
+	stats.peak = m_events.GetHighWaterMark();
+	__set_PRIMASK ( priMask );
+
+	stats.maxLatencyUs = m_ulMaxEventLatencyUs;
+	return stats;
 }
 
 /**
@@ -279,28 +347,43 @@ void HormannUAP1::SetStateChangedCallback ( StateChangedCallback cb )
 }
 
 // ═════════════════════════════════════════════════════════════════════════════
-// ISR-called event dispatcher
+// Event queue and dispatcher
 // ═════════════════════════════════════════════════════════════════════════════
 
 /**
- * @brief Dispatches an event through the door state-transition table.
- * @details Called from ISR context by DoorStatusPin. Selects the handler
- *          function for the current state and event combination and calls it.
- *          Must be short and must not make SPI/WiFi calls.
+ * @brief Queues a pin event for Update() to dispatch.
+ * @details Called from ISR context by DoorStatusPin. Only stores the event and its
+ *          micros() timestamp, so the ISR stays a few cycles long and never touches the
+ *          heap. Nothing events need no action and are not queued. If the queue is full the
+ *          event is dropped and counted (see GetEventQueueStats()).
  * @param eEvent The event that occurred (DoorOpened, DoorClosed, SwitchPress, etc.).
  */
+void HormannUAP1::QueueEvent ( HormannUAP1::Event eEvent )
+{
+	if ( eEvent != Event::Nothing )
+	{
+		m_events.Push ( eEvent );
+	}
+}
+
+/**
+ * @brief Dispatches an event through the door state-transition table.
+ * @details Called from Update() in loop context. Selects the handler function for the
+ *          current state and event combination and calls it.
+ * @param eEvent The event to dispatch.
+ */
 void HormannUAP1::DoEvent ( HormannUAP1::Event eEvent )
 {
 	( this->*StateTableFn [ (uint8_t)GetState() ][ (uint8_t)eEvent ] ) ( eEvent );
 }
 
 // ═════════════════════════════════════════════════════════════════════════════
-// State table handlers (called from ISR — must be short, no SPI/WiFi calls)
+// State table handlers (called from Update() via DoEvent())
 // ═════════════════════════════════════════════════════════════════════════════
 
 /**
  * @brief State-table handler: the door has reached the fully-open position.
- * @details Updates state to Open and direction to Up. Called from ISR.
+ * @details Updates state to Open and direction to Up. Called from Update().
  */
 void HormannUAP1::NowOpen ( Event )
 {
@@ -309,7 +392,7 @@ void HormannUAP1::NowOpen ( Event )
 
 /**
  * @brief State-table handler: the door has reached the fully-closed position.
- * @details Updates state to Closed and direction to Down. Called from ISR.
+ * @details Updates state to Closed and direction to Down. Called from Update().
  */
 void HormannUAP1::NowClosed ( Event )
 {
@@ -318,7 +401,7 @@ void HormannUAP1::NowClosed ( Event )
 
 /**
  * @brief State-table handler: the door has started moving toward the closed position.
- * @details Updates state to Closing and direction to Down. Called from ISR.
+ * @details Updates state to Closing and direction to Down. Called from Update().
  */
 void HormannUAP1::NowClosing ( Event )
 {
@@ -327,7 +410,7 @@ void HormannUAP1::NowClosing ( Event )
 
 /**
  * @brief State-table handler: the door has started moving toward the open position.
- * @details Updates state to Opening and direction to Up. Called from ISR.
+ * @details Updates state to Opening and direction to Up. Called from Update().
  */
 void HormannUAP1::NowOpening ( Event )
 {
@@ -338,7 +421,7 @@ void HormannUAP1::NowOpening ( Event )
  * @brief State-table handler: the physical wall switch has been pressed.
  * @details Implements context-sensitive logic: opens a closed door, closes an open
  *          door, stops a moving door, or resumes movement based on last direction
- *          when the door is stopped. Called from ISR context.
+ *          when the door is stopped. Called from Update().
  */
 void HormannUAP1::SwitchPressed ( Event )
 {
@@ -374,14 +457,14 @@ void HormannUAP1::SwitchPressed ( Event )
 					m_pDoorCloseCtrlPin->On();
 					break;
 				default:
-					Info ( F ( "Switch pressed when door stopped, unknown last direction — doing nothing" ), true );
+					Info ( F ( "Switch pressed when door stopped, unknown last direction — doing nothing" ) );
 					break;
 			}
 			break;
 
 		case IGarageDoor::State::Bad:
 		case IGarageDoor::State::Unknown:
-			Info ( F ( "Switch pressed when state is bad / unknown, doing nothing" ), true );
+			Info ( F ( "Switch pressed when state is bad / unknown, doing nothing" ) );
 			break;
 	}
 	m_ulSwitchPressedTime = now;
@@ -471,7 +554,7 @@ void HormannUAP1::ResetTimer ()
 	                             (aMemberFunction)&HormannUAP1::TurnOffControlPins,
 	                             SIGNAL_PULSE ) )
 	{
-		Error ( F ( "Timer callback add failed" ), true );
+		Error ( F ( "Timer callback add failed" ) );
 	}
 }
 
@@ -584,8 +667,8 @@ void HormannUAP1::GetPinStates ( String& states )
 
 /**
  * @brief Constructs a door status input pin that forwards pin events to the HormannUAP1 state machine.
- * @details Extends InputPin with match and unmatch events that are dispatched via
- *          HormannUAP1::DoEvent() when the pin transitions. When pDoor is nullptr no
+ * @details Extends InputPin with match and unmatch events that are queued via
+ *          HormannUAP1::QueueEvent() when the pin transitions. When pDoor is nullptr no
  *          events are dispatched (used for the light status pin).
  * @param pDoor           Pointer to the owning HormannUAP1 instance; may be nullptr.
  * @param matchEvent      Event to fire when the pin reaches the matched (active) state.
@@ -614,27 +697,27 @@ DoorStatusPin::DoorStatusPin ( HormannUAP1* pDoor,
 
 /**
  * @brief Called by InputPin when the pin reaches the match state.
- * @details Fires the configured matchEvent on the owning HormannUAP1 door object.
+ * @details Queues the configured matchEvent on the owning HormannUAP1 door object.
  *          Called from ISR context.
  */
 void DoorStatusPin::MatchAction () const
 {
 	if ( m_pDoor != nullptr )
 	{
-		m_pDoor->DoEvent ( m_doorMatchEvent );
+		m_pDoor->QueueEvent ( m_doorMatchEvent );
 	}
 }
 
 /**
  * @brief Called by InputPin when the pin leaves the match state.
- * @details Fires the configured unmatchEvent on the owning HormannUAP1 door object.
+ * @details Queues the configured unmatchEvent on the owning HormannUAP1 door object.
  *          Called from ISR context.
  */
 void DoorStatusPin::UnmatchAction () const
 {
 	if ( m_pDoor != nullptr )
 	{
-		m_pDoor->DoEvent ( m_doorUnmatchEvent );
+		m_pDoor->QueueEvent ( m_doorUnmatchEvent );
 	}
 }
 
@@ -721,13 +804,27 @@ IGarageDoor::State DoorStatusCalc::GetDoorState () const
 
 /**
  * @brief Stores a new door state.
+ * @details Counts actual changes so snapshots can carry a change sequence number.
  * @param state The state to persist in this calculator.
  */
 void DoorStatusCalc::SetDoorState ( IGarageDoor::State state )
 {
+	if ( state != m_currentState )
+	{
+		m_ulChangeCount++;
+	}
 	m_currentState = state;
 }
 
+/**
+ * @brief Returns how many times the stored door state has changed.
+ * @return Count of SetDoorState() calls that changed the state.
+ */
+uint32_t DoorStatusCalc::GetChangeCount () const
+{
+	return m_ulChangeCount;
+}
+
 /**
  * @brief Returns the last-known door travel direction stored in this calculator.
  * @return Direction::Up, Direction::Down, or Direction::None.
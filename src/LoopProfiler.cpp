@@ -0,0 +1,201 @@
+/*
+ * LoopProfiler.cpp
+ *
+ * Implements LoopProfiler and the LoopStages.h markers, which feed the
+ * profiler (LOOP_PROFILER) and/or the env:native harness timeline (LOOP_TRACE).
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "LoopProfiler.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#ifdef LOOP_PROFILER
+
+LoopProfiler theLoopProfiler;
+
+static const char* const SLOT_NAMES [ LoopProfiler::SLOT_COUNT ] = { "led",     "onboard", "udp",   "sensor",
+                                                                      "display", "door",    "sendq", "pass" };
+
+// ─── Markers ──────────────────────────────────────────────────────────────────
+/**
+ * @brief Ends the timing of the current stage, if any, and starts timing the next.
+ * @details The first stage of a pass also marks the start of the pass.
+ * @param stage The stage the loop is entering.
+ */
+void LoopProfiler::StageBegin ( LoopStage stage )
+{
+	uint32_t now = micros();
+	if ( m_stage < 0 )
+	{
+		m_ulPassStartUs = now;
+	}
+	else
+	{
+		Record ( (uint8_t)m_stage, now - m_ulStageStartUs );
+	}
+	m_stage = (int8_t)stage;
+	m_ulStageStartUs = now;
+}
+
+/**
+ * @brief Ends the timing of the last stage and of the whole pass.
+ */
+void LoopProfiler::PassEnd ()
+{
+	if ( m_stage < 0 )
+	{
+		return;
+	}
+	uint32_t now = micros();
+	Record ( (uint8_t)m_stage, now - m_ulStageStartUs );
+	Record ( PASS_SLOT, now - m_ulPassStartUs );
+	m_stage = -1;
+	m_ulPasses++;
+}
+
+// ─── Record ───────────────────────────────────────────────────────────────────
+/**
+ * @brief Adds one duration to a slot's histogram and maximum.
+ * @details When the target bucket is full, all of the slot's buckets are halved
+ *          (rounding up, so rare buckets are not lost) before counting.
+ * @param slot Stage index or PASS_SLOT.
+ * @param us   Duration in microseconds.
+ */
+void LoopProfiler::Record ( uint8_t slot, uint32_t us )
+{
+	uint8_t bucket = us < 2 ? 0 : (uint8_t)( 31 - __builtin_clz ( us ) );
+	if ( bucket >= BUCKET_COUNT )
+	{
+		bucket = BUCKET_COUNT - 1;
+	}
+	uint16_t* pCounts = m_histogram [ slot ];
+	if ( pCounts [ bucket ] == UINT16_MAX )
+	{
+		for ( uint8_t i = 0; i < BUCKET_COUNT; i++ )
+		{
+			pCounts [ i ] = (uint16_t)( ( pCounts [ i ] + 1U ) / 2U );
+		}
+	}
+	pCounts [ bucket ]++;
+	if ( us > m_maxUs [ slot ] )
+	{
+		m_maxUs [ slot ] = us;
+	}
+}
+
+// ─── Queries ──────────────────────────────────────────────────────────────────
+/**
+ * @brief Returns the largest duration recorded for a slot since the last Reset().
+ * @param slot Stage index or PASS_SLOT.
+ * @return Maximum in microseconds.
+ */
+uint32_t LoopProfiler::GetMaxUs ( uint8_t slot ) const
+{
+	return slot < SLOT_COUNT ? m_maxUs [ slot ] : 0UL;
+}
+
+/**
+ * @brief Returns an upper bound for a percentile of a slot's durations.
+ * @details Walks the histogram to the bucket holding the requested rank and
+ *          returns the top of that bucket, capped at the observed maximum.
+ * @param slot    Stage index or PASS_SLOT.
+ * @param percent Percentile, 1–100.
+ * @return Upper bound in microseconds, or 0 if nothing has been recorded.
+ */
+uint32_t LoopProfiler::GetPercentileUs ( uint8_t slot, uint8_t percent ) const
+{
+	if ( slot >= SLOT_COUNT )
+	{
+		return 0UL;
+	}
+	const uint16_t* pCounts = m_histogram [ slot ];
+	uint32_t total = 0UL;
+	for ( uint8_t i = 0; i < BUCKET_COUNT; i++ )
+	{
+		total += pCounts [ i ];
+	}
+	if ( total == 0 )
+	{
+		return 0UL;
+	}
+	uint32_t rank = ( total * percent + 99UL ) / 100UL;  // 1-based rank of the percentile sample
+	uint32_t seen = 0UL;
+	uint8_t bucket = 0;
+	for ( ; bucket < BUCKET_COUNT - 1; bucket++ )
+	{
+		seen += pCounts [ bucket ];
+		if ( seen >= rank )
+		{
+			break;
+		}
+	}
+	uint32_t upperUs = bucket == BUCKET_COUNT - 1 ? m_maxUs [ slot ] : ( 2UL << bucket ) - 1UL;
+	return upperUs < m_maxUs [ slot ] ? upperUs : m_maxUs [ slot ];
+}
+
+/**
+ * @brief Returns the number of complete loop passes profiled since the last Reset().
+ */
+uint32_t LoopProfiler::GetPassCount () const
+{
+	return m_ulPasses;
+}
+
+/**
+ * @brief Clears all histograms, maxima and the pass count.
+ * @details A pass in progress is still completed normally.
+ */
+void LoopProfiler::Reset ()
+{
+	memset ( m_histogram, 0, sizeof ( m_histogram ) );
+	memset ( m_maxUs, 0, sizeof ( m_maxUs ) );
+	m_ulPasses = 0UL;
+}
+
+/**
+ * @brief Returns the short display name of a slot.
+ * @param slot Stage index or PASS_SLOT.
+ */
+const char* LoopProfiler::SlotName ( uint8_t slot )
+{
+	return slot < SLOT_COUNT ? SLOT_NAMES [ slot ] : "?";
+}
+
+#endif
+
+// ─── LoopStages.h markers ─────────────────────────────────────────────────────
+
+#if defined( LOOP_PROFILER ) || defined( LOOP_TRACE )
+/**
+ * @brief Marks the start of a loop stage.
+ * @param stage The stage the loop is entering.
+ */
+void LoopStageBegin ( LoopStage stage )
+{
+#ifdef LOOP_PROFILER
+	theLoopProfiler.StageBegin ( stage );
+#endif
+#ifdef LOOP_TRACE
+	LoopTraceStage ( stage );
+#endif
+}
+
+/**
+ * @brief Marks the end of a loop pass.
+ */
+void LoopPassEnd ()
+{
+#ifdef LOOP_PROFILER
+	theLoopProfiler.PassEnd();
+#endif
+#ifdef LOOP_TRACE
+	LoopTracePassEnd();
+#endif
+}
+#endif
@@ -0,0 +1,104 @@
+/*
+ * OutboundPacketQueue.cpp
+ *
+ * See OutboundPacketQueue.h for interface documentation.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "OutboundPacketQueue.h"
+
+/**
+ * @brief Appends a datagram to the tail of the queue.
+ * @details If the queue is already full the oldest entry is discarded (and counted) so the
+ *          new packet always fits.
+ * @param dest    Destination IP address.
+ * @param port    Destination UDP port.
+ * @param payload Message bytes to copy into the queue.
+ * @param length  Number of bytes in payload.
+ * @return true if the packet was queued; false if length exceeds SEND_QUEUE_MAX_PAYLOAD.
+ */
+bool OutboundPacketQueue::Push ( IPAddress dest, uint16_t port, const char* payload, size_t length )
+{
+	if ( length > SEND_QUEUE_MAX_PAYLOAD )
+	{
+		return false;
+	}
+	if ( m_count == SEND_QUEUE_DEPTH )
+	{
+		// full - discard oldest
+		Pop();
+		m_ulDropped++;
+	}
+	Packet& packet = m_packets [ ( m_head + m_count ) % SEND_QUEUE_DEPTH ];
+	packet.dest = dest;
+	packet.port = port;
+	packet.length = (uint8_t)length;
+	memcpy ( packet.payload, payload, length );
+	m_count++;
+	if ( m_count > m_highWaterMark )
+	{
+		m_highWaterMark = m_count;
+	}
+	return true;
+}
+
+/**
+ * @brief Returns the oldest queued packet without removing it.
+ * @return Pointer to the packet at the head of the queue, or nullptr if the queue is empty.
+ */
+const OutboundPacketQueue::Packet* OutboundPacketQueue::Peek () const
+{
+	return m_count == 0 ? nullptr : &m_packets [ m_head ];
+}
+
+/**
+ * @brief Removes the oldest queued packet.  Does nothing if the queue is empty.
+ */
+void OutboundPacketQueue::Pop ()
+{
+	if ( m_count > 0 )
+	{
+		m_head = ( m_head + 1 ) % SEND_QUEUE_DEPTH;
+		m_count--;
+	}
+}
+
+/**
+ * @brief Checks whether any packets are waiting to be sent.
+ * @return true if the queue holds no packets.
+ */
+bool OutboundPacketQueue::IsEmpty () const
+{
+	return m_count == 0;
+}
+
+/**
+ * @brief Returns the number of packets currently queued.
+ * @return Count in the range [0, SEND_QUEUE_DEPTH].
+ */
+uint8_t OutboundPacketQueue::Count () const
+{
+	return m_count;
+}
+
+/**
+ * @brief Returns the largest number of packets that have been queued at once since boot.
+ * @return High-water mark in the range [0, SEND_QUEUE_DEPTH].
+ */
+uint8_t OutboundPacketQueue::GetHighWaterMark () const
+{
+	return m_highWaterMark;
+}
+
+/**
+ * @brief Returns the number of packets discarded because the queue was full.
+ * @return Cumulative count of overflow drops since boot.
+ */
+uint32_t OutboundPacketQueue::GetDroppedCount () const
+{
+	return m_ulDropped;
+}
@@ -0,0 +1,229 @@
+/*
+ * Scheduler.cpp
+ *
+ * Implements Scheduler — see Scheduler.h.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ *   Ver 1.1   Idle() sleep with duty-cycle measurement
+ */
+
+#include "Scheduler.h"
+
+#include <Arduino.h>
+
+// ─── AddTask ──────────────────────────────────────────────────────────────────
+/**
+ * @brief Registers a task in the fixed task table.
+ * @details The table is kept in priority order; tasks of equal priority run in
+ *          the order they were added. The task is due immediately.
+ * @param name       Short name for the status screen.
+ * @param function   Function to run.
+ * @param stage      Loop stage the run is attributed to by the profiler.
+ * @param periodMs   Interval between runs; 0 runs the task on every pass.
+ * @param priority   Lower values run first.
+ * @param deadlineMs How late a run may start before it counts as missed.
+ * @param budgetUs   Expected longest run; longer runs count as overruns.
+ * @return false if SCHEDULER_MAX_TASKS tasks are already registered.
+ */
+bool Scheduler::AddTask ( const char* name,
+                          TaskFunction function,
+                          LoopStage stage,
+                          uint32_t periodMs,
+                          uint8_t priority,
+                          uint32_t deadlineMs,
+                          uint32_t budgetUs )
+{
+	if ( m_taskCount >= SCHEDULER_MAX_TASKS || function == nullptr )
+	{
+		return false;
+	}
+	uint8_t slot = m_taskCount;
+	while ( slot > 0 && m_tasks [ slot - 1 ].priority > priority )
+	{
+		m_tasks [ slot ] = m_tasks [ slot - 1 ];
+		slot--;
+	}
+	Task& task = m_tasks [ slot ];
+	task.name = name;
+	task.function = function;
+	task.periodUs = periodMs * 1000UL;
+	task.deadlineUs = deadlineMs * 1000UL;
+	task.budgetUs = budgetUs;
+	task.nextDueUs = micros();
+	task.priority = priority;
+	task.stage = stage;
+	task.stats = {};
+	task.stats.name = name;
+	m_taskCount++;
+	return true;
+}
+
+// ─── RunDue ───────────────────────────────────────────────────────────────────
+/**
+ * @brief Runs each due task once, in priority order, recording its statistics.
+ * @details Every-pass tasks always run. A periodic task that is due after the
+ *          pass has already used SCHEDULER_PASS_BUDGET_US is deferred to the next
+ *          pass; its start delay then shows up in its lateness. A periodic task
+ *          keeps a fixed rate, but if it falls more than a period behind its next
+ *          run is scheduled a full period from now instead of bunching up.
+ */
+void Scheduler::RunDue ()
+{
+	uint32_t passStartUs = micros();
+	for ( uint8_t i = 0; i < m_taskCount; i++ )
+	{
+		Task& task = m_tasks [ i ];
+		uint32_t startUs = micros();
+		int32_t lateUs = (int32_t)( startUs - task.nextDueUs );
+		if ( lateUs < 0 )
+		{
+			continue;
+		}
+		if ( task.periodUs != 0 && startUs - passStartUs >= SCHEDULER_PASS_BUDGET_US )
+		{
+			task.stats.deferrals++;
+			continue;
+		}
+
+		LoopStageBegin ( task.stage );
+		task.function();
+		uint32_t endUs = micros();
+		uint32_t runUs = endUs - startUs;
+
+		TaskStats& stats = task.stats;
+		stats.runs++;
+		if ( runUs > stats.maxRunUs )
+		{
+			stats.maxRunUs = runUs;
+		}
+		if ( (uint32_t)lateUs > stats.maxLateUs )
+		{
+			stats.maxLateUs = (uint32_t)lateUs;
+		}
+		if ( (uint32_t)lateUs > task.deadlineUs )
+		{
+			stats.missed++;
+		}
+		if ( runUs > task.budgetUs )
+		{
+			stats.overruns++;
+		}
+
+		if ( task.periodUs == 0 )
+		{
+			task.nextDueUs = endUs;
+		}
+		else
+		{
+			task.nextDueUs += task.periodUs;
+			if ( (int32_t)( startUs - task.nextDueUs ) >= 0 )
+			{
+				task.nextDueUs = startUs + task.periodUs;
+			}
+		}
+	}
+	LoopPassEnd();
+}
+
+// ─── Idle ─────────────────────────────────────────────────────────────────────
+/**
+ * @brief Puts the CPU to sleep until the next interrupt, unless a periodic task is due.
+ * @details __WFI() enters the SAMD21's IDLE sleep (the reset configuration:
+ *          PM->SLEEP IDLE0, SCR.SLEEPDEEP clear), which stops only the CPU clock,
+ *          so SysTick, the EIC, SERCOM (the NINA SPI link) and USB keep running
+ *          and any of their interrupts ends the sleep. SysTick fires every
+ *          millisecond, so no sleep lasts longer than that. An interrupt serviced
+ *          between the last task and the __WFI() is picked up at the next tick at
+ *          the latest.
+ */
+void Scheduler::Idle ()
+{
+	uint32_t startUs = micros();
+	for ( uint8_t i = 0; i < m_taskCount; i++ )
+	{
+		const Task& task = m_tasks [ i ];
+		if ( task.periodUs != 0 && (int32_t)( startUs - task.nextDueUs ) >= 0 )
+		{
+			UpdateDutyCycle ( startUs );
+			return;
+		}
+	}
+	__WFI();
+	uint32_t endUs = micros();
+	uint32_t sleptUs = endUs - startUs;
+	m_ulWindowSleepUs += sleptUs;
+	m_ulSleepRemainderUs += sleptUs;
+	m_ulTotalSleepMs += m_ulSleepRemainderUs / 1000UL;
+	m_ulSleepRemainderUs %= 1000UL;
+	m_ulSleeps++;
+	UpdateDutyCycle ( endUs );
+}
+
+/**
+ * @brief Closes the duty-cycle window once IDLE_STATS_WINDOW_MS has elapsed.
+ * @param nowUs Current micros().
+ */
+void Scheduler::UpdateDutyCycle ( uint32_t nowUs )
+{
+	uint32_t elapsedUs = nowUs - m_ulWindowStartUs;
+	if ( elapsedUs < IDLE_STATS_WINDOW_MS * 1000UL )
+	{
+		return;
+	}
+	uint32_t sleepUs = m_ulWindowSleepUs < elapsedUs ? m_ulWindowSleepUs : elapsedUs;
+	m_awakePermille = (uint16_t)( 1000UL - sleepUs / ( elapsedUs / 1000UL ) );
+	m_ulWindowStartUs = nowUs;
+	m_ulWindowSleepUs = 0UL;
+}
+
+// ─── Statistics ───────────────────────────────────────────────────────────────
+/**
+ * @brief Returns the number of registered tasks.
+ */
+uint8_t Scheduler::GetTaskCount () const
+{
+	return m_taskCount;
+}
+
+/**
+ * @brief Returns a copy of one task's statistics.
+ * @param index Task index in priority order, below GetTaskCount().
+ * @return The statistics, or an empty record for an invalid index.
+ */
+Scheduler::TaskStats Scheduler::GetTaskStats ( uint8_t index ) const
+{
+	if ( index >= m_taskCount )
+	{
+		TaskStats none = {};
+		none.name = "";
+		return none;
+	}
+	return m_tasks [ index ].stats;
+}
+
+/**
+ * @brief Returns the share of the last duty-cycle window spent awake, in tenths of a percent.
+ */
+uint16_t Scheduler::GetAwakePermille () const
+{
+	return m_awakePermille;
+}
+
+/**
+ * @brief Returns the number of times Idle() has slept since boot.
+ */
+uint32_t Scheduler::GetSleepCount () const
+{
+	return m_ulSleeps;
+}
+
+/**
+ * @brief Returns the total time spent asleep in Idle() since boot, in milliseconds.
+ */
+uint32_t Scheduler::GetTotalSleepMs () const
+{
+	return m_ulTotalSleepMs;
+}
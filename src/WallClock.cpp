@@ -0,0 +1,177 @@
+/*
+ * WallClock.cpp
+ *
+ * See WallClock.h for interface documentation.
+ *
+ * Author: (c) M. Naylor 2026
+ *
+ * History:
+ *   Ver 1.0   Initial version
+ */
+
+#include "WallClock.h"
+
+/**
+ * @brief Adds the millis() elapsed since the previous call to the 64-bit elapsed counter.
+ * @details Unsigned subtraction makes this correct across the 49-day millis() wrap as long as
+ *          it is called at least once per wrap period.
+ */
+void WallClock::Tick ()
+{
+	uint32_t ulNow = millis();
+	m_ullMonoMs += ulNow - m_ulLastMillis;
+	m_ulLastMillis = ulNow;
+}
+
+/**
+ * @brief Returns the extended millisecond count without modifying state.
+ * @return Milliseconds since boot as a 64-bit value.
+ */
+uint64_t WallClock::NowMonoMs () const
+{
+	return m_ullMonoMs + (uint32_t)( millis() - m_ulLastMillis );
+}
+
+/**
+ * @brief Checks whether the clock should be resynchronised from NTP now.
+ * @return true if never synced and the retry time has passed, or the resync interval has elapsed.
+ */
+bool WallClock::IsSyncDue () const
+{
+	return NowMonoMs() >= m_ullNextSyncMonoMs;
+}
+
+/**
+ * @brief Records an authoritative epoch time and updates the drift estimate.
+ * @details The correction (true minus predicted time) decides the next resync interval. Drift is
+ *          measured against the first sync so the estimate sharpens as the baseline grows; an
+ *          implausible drift is treated as a step in the time source and restarts the baseline.
+ * @param epochSecs Seconds since 1970 UTC, as returned by WiFi.getTime().
+ */
+void WallClock::Sync ( uint32_t epochSecs )
+{
+	Tick();
+	uint64_t ullEpochMs = (uint64_t)epochSecs * 1000ULL;
+
+	if ( m_bSynced )
+	{
+		m_lastCorrectionMs = (int32_t)( (int64_t)ullEpochMs - (int64_t)GetEpochMs() );
+
+		int64_t baselineMs = (int64_t)( m_ullMonoMs - m_ullBaseMonoMs );
+		if ( baselineMs >= (int64_t)CLOCK_DRIFT_MIN_BASELINE_MS )
+		{
+			int64_t trueElapsedMs = (int64_t)ullEpochMs - (int64_t)m_ullBaseEpochMs;
+			int64_t driftPpm = ( trueElapsedMs - baselineMs ) * 1000000LL / baselineMs;
+			if ( driftPpm > CLOCK_MAX_DRIFT_PPM || driftPpm < -CLOCK_MAX_DRIFT_PPM )
+			{
+				// the time source stepped - start a fresh baseline
+				m_driftPpm = 0;
+				m_ullBaseEpochMs = ullEpochMs;
+				m_ullBaseMonoMs = m_ullMonoMs;
+			}
+			else
+			{
+				m_driftPpm = (int32_t)driftPpm;
+			}
+		}
+
+		if ( abs ( m_lastCorrectionMs ) <= (int32_t)CLOCK_MAX_CORRECTION_MS )
+		{
+			m_ulResyncIntervalMs = min ( m_ulResyncIntervalMs * 2, CLOCK_RESYNC_MAX_MS );
+		}
+		else
+		{
+			m_ulResyncIntervalMs = max ( m_ulResyncIntervalMs / 2, CLOCK_RESYNC_MIN_MS );
+		}
+	}
+	else
+	{
+		m_ullBaseEpochMs = ullEpochMs;
+		m_ullBaseMonoMs = m_ullMonoMs;
+	}
+
+	m_ullSyncEpochMs = ullEpochMs;
+	m_ullSyncMonoMs = m_ullMonoMs;
+	m_bSynced = true;
+	m_ulSyncCount++;
+	m_ullNextSyncMonoMs = m_ullMonoMs + m_ulResyncIntervalMs;
+}
+
+/**
+ * @brief Records a failed sync attempt (no NTP time available yet) and schedules a retry.
+ */
+void WallClock::SyncFailed ()
+{
+	m_ullNextSyncMonoMs = NowMonoMs() + CLOCK_SYNC_RETRY_MS;
+}
+
+/**
+ * @brief Checks whether the clock has been synchronised at least once.
+ * @return true once Sync() has been called.
+ */
+bool WallClock::IsSynced () const
+{
+	return m_bSynced;
+}
+
+/**
+ * @brief Returns the current UTC time in whole seconds.
+ * @return Seconds since 1970 UTC, or 0 if the clock has never been synced.
+ */
+uint32_t WallClock::GetEpoch () const
+{
+	return (uint32_t)( GetEpochMs() / 1000ULL );
+}
+
+/**
+ * @brief Returns the current UTC time with millisecond resolution.
+ * @details Last synced epoch plus elapsed time, with the elapsed time corrected by the drift
+ *          estimate. No SPI traffic is involved.
+ * @return Milliseconds since 1970 UTC, or 0 if the clock has never been synced.
+ */
+uint64_t WallClock::GetEpochMs () const
+{
+	if ( !m_bSynced )
+	{
+		return 0ULL;
+	}
+	int64_t elapsedMs = (int64_t)( NowMonoMs() - m_ullSyncMonoMs );
+	elapsedMs += elapsedMs * m_driftPpm / 1000000LL;
+	return m_ullSyncEpochMs + elapsedMs;
+}
+
+/**
+ * @brief Returns the estimated drift of millis() against NTP.
+ * @return Parts per million; positive when millis() runs slow. 0 until the baseline is long enough.
+ */
+int32_t WallClock::GetDriftPpm () const
+{
+	return m_driftPpm;
+}
+
+/**
+ * @brief Returns the correction applied by the most recent sync.
+ * @return Milliseconds by which the true time differed from the clock's prediction.
+ */
+int32_t WallClock::GetLastCorrectionMs () const
+{
+	return m_lastCorrectionMs;
+}
+
+/**
+ * @brief Returns the number of successful syncs since boot.
+ * @return Count of Sync() calls.
+ */
+uint32_t WallClock::GetSyncCount () const
+{
+	return m_ulSyncCount;
+}
+
+/**
+ * @brief Returns the interval that will be used before the next resync.
+ * @return Milliseconds, in the range [CLOCK_RESYNC_MIN_MS, CLOCK_RESYNC_MAX_MS].
+ */
+uint32_t WallClock::GetResyncIntervalMs () const
+{
+	return m_ulResyncIntervalMs;
+}
@@ -9,12 +9,19 @@ Author: (c) M. Naylor 2022
 History:
     Ver 1.0			Initial version
     Ver 2.0			Added onboarding support with BlobStorage
+    Ver 2.1			Network-info snapshot refreshed on connection events
+    Ver 2.2			IsConnected() reads a cached flag; WiFi.status() checked every LINK_CHECK_INTERVAL_MS
+    Ver 2.3			Local subnet added to the multicast list once per connection, not every pass
+    Ver 2.4			Multicast destinations held in a FixedIPSet; subnets expire after a lease
+    Ver 2.5			Broadcast addresses from the real subnet mask instead of classful rules
+    Ver 2.6			Per-destination send health; only failures on every destination drop the link
 */
 #include "WiFiService.h"
 
 #include "ConfigStorage.h"
 #include "HormannUAP1.h"
 
+#include <string.h>
 #include <time.h>
 #include <WiFiNINA.h>
 
@@ -35,18 +42,34 @@ const char* WiFiStatus [] = { "WL_IDLE_STATUS",  // = 0,
 constexpr auto WIFI_FLASHTIME = 10;  // every 1/2 second
 
 // Valid message parts
-constexpr char cMsgVersion1 [] = "V001";        // message version
-constexpr char TempHumidityReqMsg [] = "M001";  // Req temp / humidity
-constexpr char RestartReqMsg [] = "M002";       // Req restart
-constexpr char DoorStatusReqMsg [] = "M003";    // Req Door status
-constexpr char DoorOpenReqMsg [] = "M004";      // Req Door Open
-constexpr char DoorCloseReqMsg [] = "M005";     // Req Door Close
-constexpr char DoorStopReqMsg [] = "M006";      // Req Door Stop
-constexpr char DoorLightOnReqMsg [] = "M007";   // Req Light On
-constexpr char DoorLightOffReqMsg [] = "M008";  // Req Light off
-constexpr char PartSeparator [] = ":";
-
-constexpr auto MAX_INCOMING_UDP_MSG = 255;
+constexpr char cMsgVersion1Prefix [] = "V001:";                         // message version and separator
+constexpr size_t MSG_VERSION_LEN = sizeof ( cMsgVersion1Prefix ) - 1;  // bytes before the message code
+constexpr size_t MSG_CODE_LEN = 4;                                      // "Mnnn"
+
+/// @brief Packs four message code characters into a uint32_t, first character in the low byte.
+static constexpr uint32_t PackMsgCode ( char c0, char c1, char c2, char c3 )
+{
+	return (uint32_t)(uint8_t)c0 | ( (uint32_t)(uint8_t)c1 << 8 ) | ( (uint32_t)(uint8_t)c2 << 16 ) |
+	       ( (uint32_t)(uint8_t)c3 << 24 );
+}
+
+constexpr uint32_t MSG_CODE_FAMILY = PackMsgCode ( 'M', '0', '0', 0 );  // every V001 code is "M00n"
+constexpr uint32_t MSG_CODE_FAMILY_MASK = 0x00FFFFFFUL;                  // bytes holding "M00"
+
+// Outcome of decoding a V001 message code, indexed by its last digit.
+// Values below DECODE_RESTART are UDPWiFiService::ReqMsgType values.
+constexpr uint8_t MsgCodeTable [ 10 ] = {
+    UDPWiFiService::DECODE_UNKNOWN,         // M000
+    UDPWiFiService::ReqMsgType::TEMPDATA,   // M001 Req temp / humidity
+    UDPWiFiService::DECODE_RESTART,         // M002 Req restart
+    UDPWiFiService::ReqMsgType::DOORDATA,   // M003 Req Door status
+    UDPWiFiService::ReqMsgType::DOOROPEN,   // M004 Req Door Open
+    UDPWiFiService::ReqMsgType::DOORCLOSE,  // M005 Req Door Close
+    UDPWiFiService::ReqMsgType::DOORSTOP,   // M006 Req Door Stop
+    UDPWiFiService::ReqMsgType::LIGHTON,    // M007 Req Light On
+    UDPWiFiService::ReqMsgType::LIGHTOFF,   // M008 Req Light off
+    UDPWiFiService::ReqMsgType::STATS       // M009 Req loop profile
+};
 
 enum class eResponseMessage : uint8_t
 {
@@ -146,12 +169,54 @@ const char* WiFiService::GetHostName () const
 }
 
 /**
- * @brief Returns the current UTC epoch time obtained from the WiFi module via NTP.
- * @return Seconds since 1 January 1970 (UTC), or 0 if the time is unavailable.
+ * @brief Returns the current UTC epoch time from the cached wall clock.
+ * @details No SPI traffic: the clock is synced from NTP occasionally by ServiceClock().
+ * @return Seconds since 1 January 1970 (UTC), or 0 if the time is not yet known.
  */
 unsigned long WiFiService::GetTime () const
 {
-	return WiFi.getTime();
+	return m_clock.GetEpoch();
+}
+
+/**
+ * @brief Returns the current UTC epoch time with millisecond resolution.
+ * @return Milliseconds since 1 January 1970 (UTC), or 0 if the time is not yet known.
+ */
+uint64_t WiFiService::GetTimeMs () const
+{
+	return m_clock.GetEpochMs();
+}
+
+/**
+ * @brief Returns the wall clock, for sync and drift statistics.
+ * @return Reference to the clock maintained by ServiceClock().
+ */
+const WallClock& WiFiService::GetClock () const
+{
+	return m_clock;
+}
+
+/**
+ * @brief Keeps the wall clock running and resyncs it from NTP when due.
+ * @details Call once per loop pass. WiFi.getTime() (an SPI round trip to the NINA module) is
+ *          only made when the clock asks for a sync and the link is up; it returns 0 until the
+ *          module has obtained NTP time, in which case the sync is retried later.
+ */
+void WiFiService::ServiceClock ()
+{
+	m_clock.Tick();
+	if ( IsLinkUp() && m_clock.IsSyncDue() )
+	{
+		unsigned long epoch = WiFi.getTime();
+		if ( epoch != 0 )
+		{
+			m_clock.Sync ( epoch );
+		}
+		else
+		{
+			m_clock.SyncFailed();
+		}
+	}
 }
 
 /**
@@ -185,14 +250,58 @@ void WiFiService::SetLED ( RGBType theColour, uint8_t flashTime )
 	}
 }
 
+/**
+ * @brief Shows an activity colour on the status LED for a fixed time without blocking.
+ * @details The state colour is restored by ServiceLED() once durationMs has elapsed, so callers
+ *          no longer need to delay() to make the indication visible.
+ * @param theColour  RGB colour value to display for the duration of the pulse.
+ * @param durationMs Length of the pulse in milliseconds.
+ */
+void WiFiService::PulseLED ( RGBType theColour, uint32_t durationMs )
+{
+	SetLED ( theColour );
+	m_ulLEDPulseStartMs = millis();
+	m_ulLEDPulseDurationMs = durationMs;
+	m_bLEDPulseActive = true;
+}
+
+/**
+ * @brief Ends an expired activity pulse by restoring the colour for the current state.
+ * @details Call once per loop pass; costs a single millis() comparison when no pulse is active.
+ */
+void WiFiService::ServiceLED ()
+{
+	if ( m_bLEDPulseActive && millis() - m_ulLEDPulseStartMs >= m_ulLEDPulseDurationMs )
+	{
+		m_bLEDPulseActive = false;
+		ShowStateLED();
+	}
+}
+
 /**
  * @brief Updates the internal connection state and reflects the change on the status LED.
+ * @details While an activity pulse is showing, re-asserting the same state leaves the pulse
+ *          colour in place; ServiceLED() restores the state colour when the pulse expires.
  * @param state New state to apply: UNCONNECTED (flashing red), CONNECTED (green), or AP_MODE (flashing blue).
  */
 void WiFiService::SetState ( WiFiService::Status state )
 {
+	bool bChanged = ( state != m_State );
 	m_State = state;
-	switch ( state )
+	if ( m_bLEDPulseActive && !bChanged )
+	{
+		return;
+	}
+	m_bLEDPulseActive = false;
+	ShowStateLED();
+}
+
+/**
+ * @brief Sets the status LED to the colour and flash rate for the current connection state.
+ */
+void WiFiService::ShowStateLED ()
+{
+	switch ( m_State )
 	{
 		case WiFiService::Status::CONNECTED:
 			SetLED ( CONNECTED_COLOUR );
@@ -225,6 +334,7 @@ void WiFiService::Begin ( const char* apSSID, const char* apPassword, MNRGBLEDBa
 	m_useOnboarding = true;
 
 	WiFi.setHostname ( "GarageControl" );
+	WiFi.macAddress ( m_netInfo.mac );
 
 	String fv = WiFi.firmwareVersion();
 	if ( fv < WIFI_FIRMWARE_LATEST_VERSION )
@@ -260,6 +370,7 @@ void WiFiService::BeginWithConfig ( const char* HostName,
 	m_pLED = pLED;
 
 	WiFi.setHostname ( m_HostName );
+	WiFi.macAddress ( m_netInfo.mac );
 
 	String fv = WiFi.firmwareVersion();
 	if ( fv < WIFI_FIRMWARE_LATEST_VERSION )
@@ -270,8 +381,11 @@ void WiFiService::BeginWithConfig ( const char* HostName,
 	}
 	else
 	{
-		// Set the initial state to UNCONNECTED as the WiFi connection has not been established yet
+		// Set the initial state to UNCONNECTED as the WiFi connection has not been established yet;
+		// the connection state machine makes the first attempt on its next pass
 		SetState ( Status::UNCONNECTED );
+		m_nextReconnectMs = millis();
+		SetLinkState ( LinkState::WAITING );
 	}
 }
 
@@ -353,45 +467,72 @@ void WiFiService::StartAP ()
 	    [ this ] () { SetLED ( MNRGBLEDBaseLib::eColour::DARK_BLUE, WIFI_FLASHTIME ); } );
 
 	Info ( "AP started. IP: " + ToIPString ( m_pOnboardingPortal->apIP() ) );
+	RefreshNetworkInfo();
+	m_isConnected = false;
+	SetLinkState ( LinkState::IDLE );
 	SetState ( Status::AP_MODE );
 }
 
 /**
  * @brief Calculates the subnet broadcast address for the device's own IP address.
+ * @details Uses the address and subnet mask in the network-info snapshot, so the result follows
+ *          the prefix length the network actually uses (a 10.0.0.0/24 network gives 10.0.0.255).
+ *          Falls back to REMOTE_SUBNET_PREFIX_LEN if no mask is known.
  * @param result Output parameter that receives the calculated broadcast address.
  */
 void WiFiService::CalcMyMulticastAddress ( IPAddress& result ) const
 {
-	CalcMulticastAddress ( WiFi.localIP(), result );
+	IPAddress mask = m_netInfo.subnetMask;
+	if ( (uint32_t)mask == 0UL )
+	{
+		mask = PrefixToSubnetMask ( REMOTE_SUBNET_PREFIX_LEN );
+	}
+	result = BroadcastAddress ( m_netInfo.localIP, mask );
 }
 
 /**
- * @brief Calculates the subnet broadcast address for a given IP using classful routing rules.
- * @param ip         Source IP address used to determine the network class and prefix.
- * @param subnetMask Output parameter that receives the broadcast address
- *                   (network prefix OR'd with all host bits set to 1).
- *                   Despite the parameter name this is a broadcast address, not a subnet mask.
+ * @brief Calculates the subnet broadcast address for the sender of a request.
+ * @details A sender on the device's own subnet gets the local broadcast address, so it is not
+ *          added a second time under a different prefix. Any other sender is assumed to be on a
+ *          subnet of REMOTE_SUBNET_PREFIX_LEN bits; its real mask cannot be seen from here.
+ * @param ip     Sender's IP address.
+ * @param result Output parameter that receives the broadcast address
+ *               (network prefix OR'd with all host bits set to 1).
  */
-void WiFiService::CalcMulticastAddress ( IPAddress ip, IPAddress& subnetMask ) const
+void WiFiService::CalcMulticastAddress ( IPAddress ip, IPAddress& result ) const
 {
-	subnetMask = IPAddress ( 0UL );  // WiFi.subnetMask();
-	uint8_t firstOctet = ( ip & 0xff );
-	if ( firstOctet > 0 && firstOctet <= 127 )
-	{
-		// class A
-		subnetMask = IPAddress ( 255, 0, 0, 0 );
-	}
-	else if ( firstOctet > 127 && firstOctet <= 191 )
+	IPAddress localMask = m_netInfo.subnetMask;
+	if ( (uint32_t)localMask != 0UL &&
+	     ( (uint32_t)ip & (uint32_t)localMask ) == ( (uint32_t)m_netInfo.localIP & (uint32_t)localMask ) )
 	{
-		// Class B
-		subnetMask = IPAddress ( 255, 255, 0, 0 );
+		result = BroadcastAddress ( ip, localMask );
 	}
-	else if ( firstOctet > 191 && firstOctet <= 223 )
+	else
 	{
-		// Class C
-		subnetMask = IPAddress ( 255, 255, 255, 0 );
+		result = BroadcastAddress ( ip, PrefixToSubnetMask ( REMOTE_SUBNET_PREFIX_LEN ) );
 	}
-	subnetMask = ( ip & subnetMask ) | ( ~subnetMask );
+}
+
+/**
+ * @brief Builds the subnet mask for a CIDR prefix length.
+ * @param prefixLen Number of network bits, 0–32; larger values are treated as 32.
+ * @return The mask, e.g. 255.255.255.0 for 24.
+ */
+IPAddress WiFiService::PrefixToSubnetMask ( uint8_t prefixLen )
+{
+	uint32_t ulMask = prefixLen == 0 ? 0UL : prefixLen >= 32 ? 0xFFFFFFFFUL : ~( 0xFFFFFFFFUL >> prefixLen );
+	return IPAddress ( (uint8_t)( ulMask >> 24 ), (uint8_t)( ulMask >> 16 ), (uint8_t)( ulMask >> 8 ), (uint8_t)ulMask );
+}
+
+/**
+ * @brief Returns the broadcast address of the subnet an address belongs to.
+ * @param ip   Any address on the subnet.
+ * @param mask The subnet mask.
+ * @return The network prefix of ip with all host bits set to 1.
+ */
+IPAddress WiFiService::BroadcastAddress ( IPAddress ip, IPAddress mask )
+{
+	return IPAddress ( ( (uint32_t)ip & (uint32_t)mask ) | ~(uint32_t)mask );
 }
 
 /**
@@ -404,10 +545,10 @@ IPAddress WiFiService::GetMulticastAddress () const
 }
 
 /**
- * @brief Attempts to connect (or reconnect) to the configured WiFi network.
- * @details No-ops if already in AP mode or already connected. Implements capped exponential
- *          backoff between attempts. If WIFI_RECONNECT_MAX_ATTEMPTS consecutive failures occur
- *          the board is hard-reset via MN::Utils::ResetBoard().
+ * @brief Connects to the configured WiFi network, blocking until the attempt completes.
+ * @details Used at boot, where nothing else can run until the link is up. Drives the same
+ *          state machine as ServiceConnection(), polling it every WIFI_CONNECT_POLL_MS until the
+ *          attempt succeeds or times out. Returns immediately if a backoff window is still open.
  * @return true if the device is (or becomes) connected to the WiFi network; false otherwise.
  */
 bool WiFiService::WiFiConnect ()
@@ -419,82 +560,291 @@ bool WiFiService::WiFiConnect ()
 		return false;
 	}
 
-	if ( IsConnected() )
+	if ( m_linkState == LinkState::IDLE )
+	{
+		m_nextReconnectMs = millis();
+		SetLinkState ( LinkState::WAITING );
+	}
+	ServiceConnection();
+	while ( m_linkState == LinkState::CONNECTING )
 	{
-		// Already up — reset counters so a future drop starts fresh backoff
-		m_reconnectAttempts = 0;
-		m_nextReconnectMs = 0;
-		return true;
+		delay ( WIFI_CONNECT_POLL_MS );
+		ServiceConnection();
 	}
+	return m_linkState == LinkState::CONNECTED;
+}
 
-	// Exponential backoff: skip this attempt if the backoff window hasn't expired
-	if ( m_nextReconnectMs != 0 && millis() < m_nextReconnectMs )
+/**
+ * @brief Advances the WiFi connection state machine by one step without blocking.
+ * @details Call once per loop pass. WAITING starts a new WiFi.begin() attempt once the backoff
+ *          window has expired; CONNECTING polls WiFi.status() every WIFI_CONNECT_POLL_MS until
+ *          connected or WIFI_CONNECT_TIMEOUT_MS elapses; CONNECTED checks WiFi.status() every
+ *          LINK_CHECK_INTERVAL_MS for the link dropping and re-samples the RSSI every
+ *          RSSI_SAMPLE_MS. A failed UDP send does not wait for the check: it calls
+ *          WiFiDisconnect(). Does nothing in IDLE (AP mode or no credentials).
+ */
+void WiFiService::ServiceConnection ()
+{
+	switch ( m_linkState )
 	{
-		return false;
+		case LinkState::IDLE:
+			break;
+
+		case LinkState::WAITING:
+			if ( (int32_t)( millis() - m_nextReconnectMs ) >= 0 )
+			{
+				StartConnectAttempt();
+			}
+			break;
+
+		case LinkState::CONNECTING:
+			if ( millis() - m_ulLastStatusPollMs >= WIFI_CONNECT_POLL_MS )
+			{
+				m_ulLastStatusPollMs = millis();
+				uint8_t status = WiFi.status();
+				if ( status == WL_CONNECTED )
+				{
+					ConnectAttemptSucceeded();
+				}
+				else if ( millis() - m_ulConnectStartMs >= WIFI_CONNECT_TIMEOUT_MS )
+				{
+					ConnectAttemptFailed ( status );
+				}
+			}
+			break;
+
+		case LinkState::CONNECTED:
+			if ( millis() - m_ulLastLinkCheckMs < LINK_CHECK_INTERVAL_MS )
+			{
+				break;
+			}
+			m_ulLastLinkCheckMs = millis();
+			m_netInfo.status = WiFi.status();
+			if ( m_netInfo.status != WL_CONNECTED )
+			{
+				m_isConnected = false;
+				Error ( F ( "WiFi connection lost" ) );
+				SetState ( WiFiService::Status::UNCONNECTED );
+				// first reconnect attempt is immediate; backoff applies to failures after that
+				m_nextReconnectMs = millis();
+				SetLinkState ( LinkState::WAITING );
+			}
+			else if ( millis() - m_ulLastRssiSampleMs >= RSSI_SAMPLE_MS )
+			{
+				m_ulLastRssiSampleMs = millis();
+				m_netInfo.rssi = WiFi.RSSI();
+			}
+			break;
+
+		default:
+			break;
 	}
+}
 
+/**
+ * @brief Issues WiFi.begin() for a new connection attempt and enters CONNECTING.
+ * @details If WIFI_RECONNECT_MAX_ATTEMPTS consecutive attempts have already failed the board is
+ *          hard-reset via MN::Utils::ResetBoard() instead.
+ */
+void WiFiService::StartConnectAttempt ()
+{
 	// Too many consecutive failures → trigger watchdog reset
 	if ( m_reconnectAttempts >= WIFI_RECONNECT_MAX_ATTEMPTS )
 	{
 		Error ( F ( "WiFi: too many reconnect failures — resetting board" ) );
 		delay ( 1000 );
 		MN::Utils::ResetBoard ( F ( "WiFi reconnect failed" ) );
-		return false;  // unreachable; silences compiler warning
+		return;  // unreachable
 	}
 
-	Info ( "WiFi reconnect attempt " + String ( m_reconnectAttempts + 1 ) );
-
-	uint8_t status;
-	uint32_t ulStart = millis();
+	Info ( "WiFi connect attempt " + String ( m_reconnectAttempts + 1 ) );
 
+	// Zero timeout makes WiFi.begin() return as soon as the request is passed to the NINA
+	// module instead of waiting for the association itself; CONNECTING polls for the result.
+	WiFi.setTimeout ( 0 );
 	WiFi.begin ( m_SSID, m_Pwd );
-	do
-	{
-		status = WiFi.status();
-		delay ( 500 );
-	} while ( status != WL_CONNECTED && ( millis() - ulStart ) < WIFI_CONNECT_TIMEOUT_MS );
+	m_ulConnectStartMs = millis();
+	m_ulLastStatusPollMs = m_ulConnectStartMs;
+	SetLinkState ( LinkState::CONNECTING );
+}
+
+/**
+ * @brief Completes a successful attempt: refreshes the network-info snapshot, records the
+ *        subnet broadcast address, resets the backoff and notifies OnConnected().
+ */
+void WiFiService::ConnectAttemptSucceeded ()
+{
+	RefreshNetworkInfo();
+	CalcMyMulticastAddress ( m_multicastAddr );
+	Info ( "Connected to " + String ( m_SSID ) );
+	SetState ( WiFiService::Status::CONNECTED );
+	m_reconnectAttempts = 0;
+	m_nextReconnectMs = 0;
+	m_beginConnects++;
+	m_isConnected = true;
+	m_ulLastLinkCheckMs = millis();
+	SetLinkState ( LinkState::CONNECTED );
+	OnConnected();
+}
 
-	if ( status != WL_CONNECTED )
+/**
+ * @brief Ends a timed-out attempt and schedules the next one using capped exponential backoff.
+ * @param status Last WiFi.status() value seen during the attempt, for the log.
+ */
+void WiFiService::ConnectAttemptFailed ( uint8_t status )
+{
+	m_netInfo.status = status;
+	m_isConnected = false;
+	m_reconnectAttempts++;
+
+	// Compute capped exponential backoff: base * 2^(attempts-1)
+	uint32_t backoffMs = WIFI_RECONNECT_BASE_DELAY_MS;
+	for ( uint8_t i = 1; i < m_reconnectAttempts && backoffMs < WIFI_RECONNECT_MAX_DELAY_MS; i++ )
+	{
+		backoffMs *= 2;
+	}
+	if ( backoffMs > WIFI_RECONNECT_MAX_DELAY_MS )
 	{
-		m_reconnectAttempts++;
+		backoffMs = WIFI_RECONNECT_MAX_DELAY_MS;
+	}
+	m_nextReconnectMs = millis() + backoffMs;
 
-		// Compute capped exponential backoff: base * 2^(attempts-1)
-		uint32_t backoffMs = WIFI_RECONNECT_BASE_DELAY_MS;
-		for ( uint8_t i = 1; i < m_reconnectAttempts && backoffMs < WIFI_RECONNECT_MAX_DELAY_MS; i++ )
-		{
-			backoffMs *= 2;
-		}
-		if ( backoffMs > WIFI_RECONNECT_MAX_DELAY_MS )
-		{
-			backoffMs = WIFI_RECONNECT_MAX_DELAY_MS;
-		}
-		m_nextReconnectMs = millis() + backoffMs;
+	SetState ( WiFiService::Status::UNCONNECTED );
+	logWiFiError ( "WiFi connect attempt " + String ( m_reconnectAttempts ), status );
+	m_beginTimeouts++;
+	SetLinkState ( LinkState::WAITING );
+}
 
-		SetState ( WiFiService::Status::UNCONNECTED );
-		logWiFiError ( "WiFi connect attempt " + String ( m_reconnectAttempts ), status );
-		m_beginTimeouts++;
-		return false;
+/**
+ * @brief Reads the network details from the NINA module into the network-info snapshot.
+ * @details Called when a connection is made and when AP mode starts; between those events
+ *          only the RSSI (sampled by ServiceConnection()) and the status change.
+ */
+void WiFiService::RefreshNetworkInfo ()
+{
+	const char* pSSID = WiFi.SSID();
+	strncpy ( m_netInfo.ssid, pSSID != nullptr ? pSSID : "", sizeof ( m_netInfo.ssid ) - 1 );
+	m_netInfo.ssid [ sizeof ( m_netInfo.ssid ) - 1 ] = 0;
+	m_netInfo.localIP = WiFi.localIP();
+	m_netInfo.subnetMask = WiFi.subnetMask();
+	m_netInfo.gatewayIP = WiFi.gatewayIP();
+	WiFi.macAddress ( m_netInfo.mac );
+	m_netInfo.rssi = WiFi.RSSI();
+	m_netInfo.status = WiFi.status();
+	m_ulLastRssiSampleMs = millis();
+}
+
+/**
+ * @brief Returns the network details as of the last connection event. See NetworkInfo.
+ */
+const WiFiService::NetworkInfo& WiFiService::GetNetworkInfo () const
+{
+	return m_netInfo;
+}
+
+/**
+ * @brief Hook called each time the connection state machine reaches CONNECTED.
+ * @details The base implementation does nothing; derived services restart their sockets here.
+ */
+void WiFiService::OnConnected ()
+{
+}
+
+/**
+ * @brief Moves the connection state machine to a new state, accumulating time-in-state totals.
+ * @param state The state to enter.
+ */
+void WiFiService::SetLinkState ( LinkState state )
+{
+	uint32_t ulNow = millis();
+	m_ulLinkStateTotalMs [ static_cast<uint8_t> ( m_linkState ) ] += ulNow - m_ulLinkStateSinceMs;
+	m_ulLinkStateSinceMs = ulNow;
+	m_linkState = state;
+}
+
+/**
+ * @brief Returns the current state of the connection state machine.
+ * @return One of IDLE, WAITING, CONNECTING or CONNECTED.
+ */
+WiFiService::LinkState WiFiService::GetLinkState () const
+{
+	return m_linkState;
+}
+
+/**
+ * @brief Checks whether the connection state machine considers the link usable.
+ * @details Like IsConnected() this does not query the NINA module.
+ * @return true when the state machine is in CONNECTED.
+ */
+bool WiFiService::IsLinkUp () const
+{
+	return m_linkState == LinkState::CONNECTED;
+}
+
+/**
+ * @brief Returns how long the connection state machine has been in its current state.
+ * @return Milliseconds since the last state change.
+ */
+uint32_t WiFiService::GetTimeInLinkState () const
+{
+	return millis() - m_ulLinkStateSinceMs;
+}
+
+/**
+ * @brief Returns the cumulative time spent in a connection state since boot.
+ * @param state The state of interest.
+ * @return Total milliseconds spent in state, including the current visit if it is active.
+ */
+uint32_t WiFiService::GetTotalTimeInLinkState ( LinkState state ) const
+{
+	uint32_t ulTotal = m_ulLinkStateTotalMs [ static_cast<uint8_t> ( state ) ];
+	if ( state == m_linkState )
+	{
+		ulTotal += GetTimeInLinkState();
 	}
-	else
+	return ulTotal;
+}
+
+/**
+ * @brief Converts a connection state to a short display string.
+ * @param state The state to describe.
+ * @return Pointer to a static string naming the state.
+ */
+const char* WiFiService::LinkStateToString ( LinkState state )
+{
+	switch ( state )
 	{
-		CalcMyMulticastAddress ( m_multicastAddr );
-		Info ( "Connected to " + String ( m_SSID ) );
-		SetState ( WiFiService::Status::CONNECTED );
-		m_reconnectAttempts = 0;
-		m_nextReconnectMs = 0;
-		m_beginConnects++;
-		return true;
+		case LinkState::IDLE:
+			return "IDLE";
+		case LinkState::WAITING:
+			return "WAITING";
+		case LinkState::CONNECTING:
+			return "CONNECTING";
+		case LinkState::CONNECTED:
+			return "CONNECTED";
+		default:
+			return "UNKNOWN";
 	}
 }
 
 /**
  * @brief Disconnects from the WiFi network and sets the connection state to UNCONNECTED.
+ * @details Unless the service is idle (AP mode or stopped) the connection state machine is
+ *          returned to WAITING so that the next ServiceConnection() starts a reconnect.
  */
 void WiFiService::WiFiDisconnect ()
 {
 	WiFi.disconnect();
+	m_netInfo.status = WL_DISCONNECTED;
+	m_isConnected = false;
 	Info ( "Disconnecting wifi" );
 	SetState ( WiFiService::Status::UNCONNECTED );
+	if ( m_linkState != LinkState::IDLE )
+	{
+		// let the state machine reconnect on its next pass
+		m_nextReconnectMs = millis();
+		SetLinkState ( LinkState::WAITING );
+	}
 }
 
 /**
@@ -508,12 +858,15 @@ String WiFiService::ToIPString ( const IPAddress& address )
 }
 
 /**
- * @brief Checks whether the WiFi module currently reports a connected status.
- * @return true if WiFi.status() == WL_CONNECTED, false otherwise.
+ * @brief Checks whether the WiFi station connection is up.
+ * @details Reads a flag kept by the connection state machine rather than querying the NINA
+ *          module: set when a connection is made, cleared as soon as a send fails or the
+ *          disconnect is seen, which is at most LINK_CHECK_INTERVAL_MS after it happens.
+ * @return true while connected to the access point, false otherwise (including AP mode).
  */
 bool WiFiService::IsConnected () const
 {
-	return WiFi.status() == WL_CONNECTED;
+	return m_isConnected;
 }
 
 /**
@@ -540,14 +893,6 @@ uint32_t WiFiService::GetBeginCount ()
  *
  */
 /***************************************************************************************************************************************/
-/**
- * @brief Constructor. Allocates the multicast destination IP list with an initial capacity of 4 entries.
- */
-UDPWiFiService::UDPWiFiService ()
-{
-	m_pMulticastDestList = new FixedIPList ( 4 );
-}
-
 /**
  * @brief Initialize UDP WiFi service with onboarding support.
  * @param pHandleReqData Callback function to handle received messages.
@@ -565,30 +910,27 @@ bool UDPWiFiService::Begin ( UDPWiFiServiceCallback pHandleReqData,
 	WiFiService::Begin ( apSSID, apPassword, pLED );
 	m_MsgHandlerCallback = pHandleReqData;
 
-	if ( m_sUDPReceivedMsg.reserve ( MAX_INCOMING_UDP_MSG ) )
+	// Check if we have valid configuration loaded
+	if ( m_config.valid && GetState() == Status::CONNECTED )
 	{
-		// Check if we have valid configuration loaded
-		if ( m_config.valid && GetState() == Status::CONNECTED )
-		{
-			m_Port = m_config.udpPort;
-			Start();
-			bResult = true;
-		}
-		else if ( GetState() == Status::AP_MODE )
-		{
-			// In AP mode, onboarding will handle configuration
-			Info ( "In AP mode - waiting for configuration" );
-			bResult = true;  // Consider initialization successful even in AP mode
-		}
-		else
+		m_Port = m_config.udpPort;
+		Start();
+		bResult = true;
+	}
+	else if ( GetState() == Status::AP_MODE )
+	{
+		// In AP mode, onboarding will handle configuration
+		Info ( "In AP mode - waiting for configuration" );
+		bResult = true;  // Consider initialization successful even in AP mode
+	}
+	else
+	{
+		SetState ( Status::UNCONNECTED );
+		bResult = false;
+		// Consider starting AP mode here if not already started
+		if ( m_useOnboarding )
 		{
-			SetState ( Status::UNCONNECTED );
-			bResult = false;
-			// Consider starting AP mode here if not already started
-			if ( m_useOnboarding )
-			{
-				StartAP();
-			}
+			StartAP();
 		}
 	}
 	return bResult;
@@ -607,134 +949,197 @@ void UDPWiFiService::ProcessOnboarding ()
 }
 
 /**
- * @brief Polls for an incoming UDP message and, if one is available, dispatches it to the
- *        registered message handler callback.
- * @details Does nothing when in AP/onboarding mode. Attempts WiFi reconnection via GetUDPMessage()
- *          if the connection has dropped.
+ * @brief Drains queued incoming UDP messages, dispatching each to the registered message
+ *        handler callback.
+ * @details Does nothing when in AP/onboarding mode. Advances WiFi reconnection via
+ *          ServiceConnection() if the connection has dropped. Handles up to UDP_DRAIN_MAX_PACKETS requests, stopping
+ *          early once UDP_DRAIN_BUDGET_US has been spent, so a burst from several clients is
+ *          cleared from the NINA socket buffer without starving the rest of the loop. A packet
+ *          that is discarded (too long, or unreadable) counts towards the drain like any other, and
+ *          draining carries on with the packets behind it.
  */
 void UDPWiFiService::CheckUDP ()
 {
+	ServiceLED();
+	ServiceClock();
+
 	// Never attempt UDP or WiFi reconnection while in AP/onboarding mode.
 	if ( GetState() == Status::AP_MODE )
 	{
 		return;
 	}
-	String Msg = "?";
-	if ( GetUDPMessage ( Msg ) )
+	ServiceConnection();
+
+	uint32_t ulStartUs = micros();
+	uint8_t drained = 0;
+	size_t len = 0;
+	bool bValid = false;
+	if ( GetUDPMessage ( len, bValid ) )
 	{
-		ProcessUDPMessage ( Msg );
+		do
+		{
+			if ( bValid )
+			{
+				ProcessUDPMessage ( m_sRecvBuffer, len );
+			}
+			drained++;
+			if ( micros() - ulStartUs >= UDP_DRAIN_BUDGET_US )
+			{
+				if ( drained < UDP_DRAIN_MAX_PACKETS )
+				{
+					m_ulDrainBudgetExhausted++;
+				}
+				break;
+			}
+		} while ( drained < UDP_DRAIN_MAX_PACKETS && ReadUDPMessage ( len, bValid ) );
+
+		if ( drained == UDP_DRAIN_MAX_PACKETS )
+		{
+			m_ulDrainLimitReached++;
+		}
 	}
+	m_lastDrained = drained;
+	m_maxDrained = max ( m_maxDrained, drained );
+	UpdateDestListStats();
 }
 
 /**
- * @brief Appends the current local time formatted as "DD/MM/YY HH:MM:SS" to the provided string.
- * @details Uses UK timezone (GMT/BST). Does nothing when in AP mode or when the time is unavailable.
- *          Note: GetTime() makes a blocking NTP call; avoid calling this frequently.
- * @param result    String to which the formatted timestamp is appended.
- * @param timeError Optional pre-fetched epoch time in seconds since 1970 UTC. If 0 the NTP time
- *                  is fetched internally via GetTime().
+ * @brief Closes the multicast destination set's operations window once DEST_LIST_STATS_MS
+ *        has elapsed.
+ * @details The window is a minute long, so the count it leaves behind is the number of list
+ *          operations per minute shown on the status screen.
  */
-void UDPWiFiService::GetLocalTime ( String& result, time_t timeError )
+void UDPWiFiService::UpdateDestListStats ()
 {
-	// WiFi.getTime() makes a blocking NTP call via NINA firmware.
-	// In AP mode there is no internet so it blocks for several seconds — skip it entirely.
-	if ( GetState() == Status::AP_MODE )
+	uint32_t ulNow = millis();
+	if ( ulNow - m_ulDestListWindowMs >= DEST_LIST_STATS_MS )
 	{
-		return;
+		uint32_t ulOps = m_multicastDests.GetOperationCount();
+		m_ulDestListOpsPerMin = ulOps - m_ulDestListWindowOps;
+		m_ulDestListWindowOps = ulOps;
+		m_ulDestListWindowMs = ulNow;
 	}
+}
 
+/**
+ * @brief Appends the current local time formatted as "DD/MM/YY HH:MM:SS.mmm" to the provided string.
+ * @details Uses UK timezone (GMT/BST). Does nothing when the time is unavailable. Reads the cached
+ *          wall clock, so it is cheap enough to call for every log line.
+ * @param result    String to which the formatted timestamp is appended.
+ * @param timeError Optional pre-fetched epoch time in seconds since 1970 UTC. If 0 the current
+ *                  time is taken from the wall clock, including milliseconds.
+ */
+void UDPWiFiService::GetLocalTime ( String& result, time_t timeError )
+{
+	uint32_t ulMillis = 0;
+	bool bShowMillis = false;
 	if ( timeError == 0 )
 	{
-		timeError = GetTime();
+		uint64_t ullNowMs = GetTimeMs();
+		timeError = (time_t)( ullNowMs / 1000ULL );
+		ulMillis = (uint32_t)( ullNowMs % 1000ULL );
+		bShowMillis = true;
 	}
 	if ( timeError != 0 )
 	{
 		tm localtm;
 		localtime_r ( &timeError, &localtm );
-		char sTime [ 20 ];
+		char sTime [ 32 ];
 		// Format: DD/MM/YY HH:MM:SS
-		sprintf ( sTime,
-		          "%02d/%02d/%02d %02d:%02d:%02d",
-		          localtm.tm_mday,
-		          localtm.tm_mon + 1,
-		          ( localtm.tm_year - 100 ),
-		          localtm.tm_hour,
-		          localtm.tm_min,
-		          localtm.tm_sec );
+		snprintf ( sTime,
+		           sizeof ( sTime ),
+		           "%02d/%02d/%02d %02d:%02d:%02d",
+		           localtm.tm_mday,
+		           localtm.tm_mon + 1,
+		           ( localtm.tm_year - 100 ) % 100,
+		           localtm.tm_hour,
+		           localtm.tm_min,
+		           localtm.tm_sec );
 		result += sTime;
+		if ( bShowMillis )
+		{
+			snprintf ( sTime, sizeof ( sTime ), ".%03u", (unsigned)ulMillis );
+			result += sTime;
+		}
 	}
 }
 
 /**
- * @brief Attempts WiFi reconnection if needed, then reads the next available UDP packet.
- * @details On reconnection after a drop the UDP listener is restarted automatically. Also
- *          refreshes the multicast destination list with the current subnet broadcast address.
- * @param RecvMessage Output: receives the content of the received UDP packet.
- * @return true if a packet was read successfully; false if not connected or no packet is available.
+ * @brief Reads the next available UDP packet if the WiFi link is up.
+ * @details Never blocks on the WiFi link: while it is down this returns false and reconnection
+ *          proceeds via ServiceConnection() over subsequent calls. The local subnet is added to the
+ *          multicast destination set by Start(), once per connection, not here.
+ * @param len    Output: length of the packet now held in m_sRecvBuffer.
+ * @param bValid Output: see ReadUDPMessage().
+ * @return true if a packet was taken from the socket; false if not connected or no packet is available.
  */
-bool UDPWiFiService::GetUDPMessage ( String& RecvMessage )
+bool UDPWiFiService::GetUDPMessage ( size_t& len, bool& bValid )
 {
-	bool wasConnected = IsConnected();
-	if ( WiFiConnect() )
+	if ( IsLinkUp() )
 	{
-		if ( !wasConnected )
-		{
-			// Just reconnected after a drop — restart the UDP listener on our port
-			Info ( F ( "WiFi reconnected \u2014 restarting UDP" ) );
-			m_myUDP.stop();
-			Start();
-		}
-		m_pMulticastDestList->Add ( GetMulticastAddress() );
-		return ReadUDPMessage ( RecvMessage );
+		return ReadUDPMessage ( len, bValid );
 	}
-	else
+	return false;
+}
+
+/**
+ * @brief Restarts the UDP listener after the WiFi link has been re-established.
+ * @details The NINA firmware invalidates sockets when it reconnects, so the listener must be
+ *          reopened. Destination skip windows are cleared, since they were most likely caused
+ *          by the link going down. Skipped for the initial boot connection, before Begin() has set the port.
+ */
+void UDPWiFiService::OnConnected ()
+{
+	ResetDestBackoff();
+	if ( m_Port != 0 )
 	{
-		SetState ( WiFiService::Status::UNCONNECTED );
-		return false;
+		Info ( F ( "WiFi reconnected \u2014 restarting UDP" ) );
+		m_myUDP.stop();
+		Start();
 	}
 }
 
 /**
- * @brief Reads one pending UDP packet into the provided string.
- * @details Packets larger than MAX_INCOMING_UDP_MSG bytes are silently discarded and counted
+ * @brief Reads one pending UDP packet into m_sRecvBuffer.
+ * @details Packets of UDP_MAX_REQUEST_LEN bytes or more are silently discarded and counted
  *          as bad requests. The sender's subnet broadcast address is added to the multicast
- *          destination list so future broadcasts reach that subnet.
- * @param sRecvMessage Output: receives the null-terminated content of the UDP packet.
- * @return true if a packet was available and read successfully; false otherwise.
+ *          destination list so future broadcasts reach that subnet. Nothing is allocated on the heap.
+ * @param len    Output: length of the null-terminated packet content now in m_sRecvBuffer.
+ * @param bValid Output: true if m_sRecvBuffer holds the packet; false if it was discarded.
+ * @return true if a packet was taken from the socket, valid or not; false if none was waiting.
  */
-bool UDPWiFiService::ReadUDPMessage ( String& sRecvMessage )
+bool UDPWiFiService::ReadUDPMessage ( size_t& len, bool& bValid )
 {
 	bool bResult = false;
-	char sBuffer [ MAX_INCOMING_UDP_MSG ];
+	bValid = false;
 
 	// if there's data available, read a packet
 	unsigned int packetSize = m_myUDP.parsePacket();
 	if ( packetSize > 0 )
 	{
-		SetLED ( PROCESSING_MSG_COLOUR );
-		delay ( 500 );
-		String logMessage = "Received packet of size " + String ( packetSize ) + " From " +
-		                    ToIPString ( m_myUDP.remoteIP() ) + ", port " + String ( m_myUDP.remotePort() );
-		// Info ( logMessage ) ;
-		if ( packetSize < sizeof ( sBuffer ) - 1 )
+		bResult = true;
+		m_ulRequestRxMicros = micros();
+		m_bReplyPending = true;
+		PulseLED ( PROCESSING_MSG_COLOUR, PROCESSING_LED_PULSE_MS );
+		if ( packetSize < sizeof ( m_sRecvBuffer ) - 1 )
 		{
 			// read the packet into packetBufffer
-			int len = m_myUDP.read ( sBuffer, sizeof ( sBuffer ) - 1 );
-			if ( len >= 0 )
+			int readLen = m_myUDP.read ( m_sRecvBuffer, sizeof ( m_sRecvBuffer ) - 1 );
+			if ( readLen >= 0 )
 			{
-				sBuffer [ len ] = 0;
-				sRecvMessage = sBuffer;
-				bResult = true;
+				m_sRecvBuffer [ readLen ] = 0;
+				len = (size_t)readLen;
+				bValid = true;
 				m_ulReqCount++;
 			}
 			else
 			{
 				Error ( "Failed to read UDP packet" );
 			}
-			// create multicast address from send ip and add to list of subnets to send multicasts to and add to list
+			// create multicast address from sender ip and add it to, or renew its lease in, the destination set
 			IPAddress result;
 			CalcMulticastAddress ( m_myUDP.remoteIP(), result );
-			m_pMulticastDestList->Add ( result );
+			m_multicastDests.Add ( result, millis() );
 		}
 		else
 		{
@@ -746,8 +1151,11 @@ bool UDPWiFiService::ReadUDPMessage ( String& sRecvMessage )
 
 /**
  * @brief Starts the UDP listener on the configured port.
- * @details Also adds the current subnet broadcast address to the multicast destination list.
- *          Resets the board if the UDP port cannot be allocated.
+ * @details Also adds the current subnet broadcast address to the multicast destination set,
+ *          pinned so that it never expires. Start() runs at boot and again from OnConnected()
+ *          after every reconnect, so this is the one place the local subnet is registered; if it
+ *          has changed, the old one is unpinned and left to expire. Resets the board if the UDP port cannot
+ *          be allocated.
  * @return true if the UDP listener was started successfully.
  */
 bool UDPWiFiService::Start ()
@@ -761,7 +1169,13 @@ bool UDPWiFiService::Start ()
 		IPAddress localSubnet = GetMulticastAddress();
 		if ( (long unsigned int)localSubnet != 0UL )
 		{
-			m_pMulticastDestList->Add ( localSubnet );
+			if ( localSubnet != m_pinnedDest )
+			{
+				// a previous local subnet now keeps its place only while its clients send requests
+				m_multicastDests.Unpin ( m_pinnedDest, millis() );
+				m_pinnedDest = localSubnet;
+			}
+			m_multicastDests.Add ( localSubnet, millis(), true );
 		}
 	}
 	else
@@ -793,20 +1207,21 @@ uint32_t UDPWiFiService::GetRequestsReceivedCount ()
 
 /**
  * @brief Sends a UDP reply to the IP address and port of the most recently received packet.
- * @param sMsg The message string to send as the reply payload.
+ * @param pMsg Buffer holding the reply payload; sent as-is, no copy is made.
+ * @param len  Length of the payload in bytes.
  * @return true if the packet was sent successfully; false on connection loss or send failure.
  */
-bool UDPWiFiService::SendReply ( String sMsg )
+bool UDPWiFiService::SendReply ( const char* pMsg, size_t len )
 {
 	bool bResult = false;
-	if ( WiFiConnect() )
+	if ( IsLinkUp() )
 	{
-		if ( sMsg.length() > 0 )
+		if ( len > 0 )
 		{
 			int beginResult = m_myUDP.beginPacket ( m_myUDP.remoteIP(), m_myUDP.remotePort() );
 			if ( beginResult == 1 )
 			{
-				m_myUDP.write ( sMsg.c_str() );
+				m_myUDP.write ( (const uint8_t*)pMsg, len );
 				if ( m_myUDP.endPacket() == 0 )
 				{
 					logWiFiError ( "Message Response", 0 );
@@ -815,6 +1230,13 @@ bool UDPWiFiService::SendReply ( String sMsg )
 				else
 				{
 					m_ulReplyCount++;
+					if ( m_bReplyPending )
+					{
+						// Time from parsePacket() of the request to this reply leaving the board
+						m_ulLastReplyLatencyUs = micros() - m_ulRequestRxMicros;
+						m_ulMaxReplyLatencyUs = max ( m_ulMaxReplyLatencyUs, m_ulLastReplyLatencyUs );
+						m_bReplyPending = false;
+					}
 					SetState ( WiFiService::Status::CONNECTED );
 					bResult = true;
 				}
@@ -835,38 +1257,39 @@ bool UDPWiFiService::SendReply ( String sMsg )
 }
 
 /**
- * @brief Broadcasts a UDP message to all known subnet multicast/broadcast addresses.
- * @param sMsg The message string to send to every entry in the multicast destination list.
- * @return true if at least one packet was sent successfully; false on connection loss or empty message.
+ * @brief Queues a UDP message for every known subnet multicast/broadcast address.
+ * @details Returns immediately; the datagrams are transmitted by ProcessSendQueue() over the
+ *          following loop passes. Subnets that have sent no request for MULTICAST_DEST_LEASE_MS
+ *          are dropped first, so no airtime is spent on them, and a destination in the skip window
+ *          left by a failed send is passed over.
+ * @param pMsg Buffer holding the payload to send to every entry in the multicast destination set.
+ * @param len  Length of the payload in bytes.
+ * @return true if at least one packet was queued; false on connection loss or empty message.
  */
-bool UDPWiFiService::SendAll ( String sMsg )
+bool UDPWiFiService::SendAll ( const char* pMsg, size_t len )
 {
 	bool bResult = false;
-	if ( WiFiConnect() )
+	if ( IsLinkUp() )
 	{
-		if ( sMsg.length() > 0 )
+		if ( len > 0 )
 		{
-			uint8_t iterator = m_pMulticastDestList->GetIterator();
+			m_multicastDests.Expire ( millis(), MULTICAST_DEST_LEASE_MS );
+			uint8_t iterator = m_multicastDests.GetIterator();
 			IPAddress nextIP;
-			while ( (long unsigned int)( nextIP = m_pMulticastDestList->GetNext ( iterator ) ) != 0UL )
+			while ( (long unsigned int)( nextIP = m_multicastDests.GetNext ( iterator ) ) != 0UL )
 			{
-				delay ( 200 );
-				if ( m_myUDP.beginPacket ( nextIP, m_config.multicastPort ) == 1 )
+				if ( IsDestSkipped ( nextIP ) )
 				{
-					m_myUDP.write ( sMsg.c_str() );
-					if ( m_myUDP.endPacket() == 0 )
-					{
-						Error ( "Multicast Message failed" );
-						WiFiDisconnect();
-					}
-					else
-					{
-						SetLED ( PROCESSING_MSG_COLOUR );
-						delay ( 500 );
-						SetState ( WiFiService::Status::CONNECTED );
-						bResult = true;
-						m_ulMCastSentCount++;
-					}
+					continue;
+				}
+				if ( m_sendQueue.Push ( nextIP, m_config.multicastPort, pMsg, len ) )
+				{
+					bResult = true;
+				}
+				else
+				{
+					Error ( "Multicast message too long to queue" );
+					break;
 				}
 			}
 		}
@@ -878,6 +1301,178 @@ bool UDPWiFiService::SendAll ( String sMsg )
 	return bResult;
 }
 
+/**
+ * @brief Send stage: transmits queued multicast datagrams without blocking the loop.
+ * @details Sends at most SEND_QUEUE_MAX_PER_PASS packets per call. Datagrams to the same
+ *          destination are spaced at least SEND_QUEUE_PACING_MS apart using timestamps rather than
+ *          delay(); SendAll() queues one datagram per destination, so a fan-out to several subnets
+ *          goes out SEND_QUEUE_MAX_PER_PASS at a time. Packets are sent in order, so a packet
+ *          waiting for its destination's gap holds back the ones behind it. Packets stay queued
+ *          while the link is down. A failed send is dropped and recorded against its destination,
+ *          which then sits out a growing skip window (see RecordDestSend()). Only when every
+ *          destination is failing is the WiFi link disconnected so the reconnect logic takes over.
+ */
+void UDPWiFiService::ProcessSendQueue ()
+{
+	for ( uint8_t sent = 0; sent < SEND_QUEUE_MAX_PER_PASS; sent++ )
+	{
+		const OutboundPacketQueue::Packet* pPacket = m_sendQueue.Peek();
+		if ( pPacket == nullptr || !IsLinkUp() || IsDestPaced ( pPacket->dest ) )
+		{
+			break;
+		}
+		uint32_t ulStartUs = micros();
+		bool bSent = false;
+		if ( m_myUDP.beginPacket ( pPacket->dest, pPacket->port ) == 1 )
+		{
+			m_myUDP.write ( (const uint8_t*)pPacket->payload, pPacket->length );
+			bSent = m_myUDP.endPacket() != 0;
+		}
+		RecordDestSend ( pPacket->dest, bSent, micros() - ulStartUs );
+		if ( !bSent )
+		{
+			Error ( "Multicast Message failed to " + ToIPString ( pPacket->dest ) );
+			m_sendQueue.Pop();
+			if ( AllDestsFailing() )
+			{
+				m_ulDestEscalations++;
+				WiFiDisconnect();
+			}
+			break;
+		}
+		PulseLED ( PROCESSING_MSG_COLOUR, PROCESSING_LED_PULSE_MS );
+		SetState ( WiFiService::Status::CONNECTED );
+		m_ulMCastSentCount++;
+		m_sendQueue.Pop();
+	}
+}
+
+/**
+ * @brief Checks whether a destination is inside the skip window left by its last failure.
+ * @details Counts the skipped send. A destination whose window has passed is tried again; if
+ *          that send fails too, the next window is twice as long.
+ * @param dest Destination address.
+ * @return true if nothing should be sent to dest now.
+ */
+bool UDPWiFiService::IsDestSkipped ( IPAddress dest )
+{
+	DestHealth* pHealth = m_multicastDests.GetValue ( dest );
+	if ( pHealth == nullptr || pHealth->skipMs == 0UL || millis() - pHealth->lastFailMs >= pHealth->skipMs )
+	{
+		return false;
+	}
+	pHealth->skipped++;
+	return true;
+}
+
+/**
+ * @brief Checks whether the last send to a destination was too recent to send to it again.
+ * @details A destination that has expired from the set since the packet was queued, or has not
+ *          been sent to yet, is never held back.
+ * @param dest Destination address.
+ * @return true if less than SEND_QUEUE_PACING_MS has passed since the last send to dest.
+ */
+bool UDPWiFiService::IsDestPaced ( IPAddress dest ) const
+{
+	const DestHealth* pHealth = m_multicastDests.GetValue ( dest );
+	if ( pHealth == nullptr || pHealth->sent + pHealth->failed == 0UL )
+	{
+		return false;
+	}
+	return millis() - pHealth->lastSendMs < SEND_QUEUE_PACING_MS;
+}
+
+/**
+ * @brief Updates a destination's send health after a send attempt.
+ * @details A success clears the failure run. A failure starts a skip window of
+ *          DEST_BACKOFF_BASE_MS, doubling with each consecutive failure up to DEST_BACKOFF_MAX_MS.
+ *          Destinations that have expired from the set since the packet was queued are ignored.
+ * @param dest   Destination address.
+ * @param bSent  true if beginPacket() and endPacket() both succeeded.
+ * @param sendUs Time spent in beginPacket() to endPacket().
+ */
+void UDPWiFiService::RecordDestSend ( IPAddress dest, bool bSent, uint32_t sendUs )
+{
+	DestHealth* pHealth = m_multicastDests.GetValue ( dest );
+	if ( pHealth == nullptr )
+	{
+		return;
+	}
+	pHealth->lastSendMs = millis();
+	pHealth->lastSendUs = sendUs;
+	pHealth->maxSendUs = max ( pHealth->maxSendUs, sendUs );
+	if ( bSent )
+	{
+		pHealth->sent++;
+		pHealth->consecutiveFailures = 0;
+		pHealth->skipMs = 0UL;
+	}
+	else
+	{
+		pHealth->failed++;
+		if ( pHealth->consecutiveFailures < UINT8_MAX )
+		{
+			pHealth->consecutiveFailures++;
+		}
+		uint32_t ulSkipMs = DEST_BACKOFF_BASE_MS;
+		for ( uint8_t i = 1; i < pHealth->consecutiveFailures && ulSkipMs < DEST_BACKOFF_MAX_MS; i++ )
+		{
+			ulSkipMs *= 2;
+		}
+		pHealth->skipMs = min ( ulSkipMs, DEST_BACKOFF_MAX_MS );
+		pHealth->lastFailMs = millis();
+	}
+}
+
+/**
+ * @brief Checks whether the last send to every destination failed.
+ * @details One unreachable subnet says nothing about the WiFi link, but when no destination can
+ *          be reached the link itself is the likely fault and is handed to link recovery.
+ * @return true if the set is not empty and every destination is in a failure run.
+ */
+bool UDPWiFiService::AllDestsFailing () const
+{
+	uint8_t iterator = m_multicastDests.GetIterator();
+	IPAddress dest;
+	bool bAnyDest = false;
+	while ( (long unsigned int)( dest = m_multicastDests.GetNext ( iterator ) ) != 0UL )
+	{
+		const DestHealth* pHealth = m_multicastDests.GetValue ( dest );
+		if ( pHealth->consecutiveFailures == 0 )
+		{
+			return false;
+		}
+		bAnyDest = true;
+	}
+	return bAnyDest;
+}
+
+/**
+ * @brief Clears every destination's failure run and skip window.
+ * @details Called when the link comes back up: failures seen while it was going down say nothing
+ *          about the destinations themselves. The sent / failed totals are kept.
+ */
+void UDPWiFiService::ResetDestBackoff ()
+{
+	uint8_t iterator = m_multicastDests.GetIterator();
+	IPAddress dest;
+	while ( (long unsigned int)( dest = m_multicastDests.GetNext ( iterator ) ) != 0UL )
+	{
+		DestHealth* pHealth = m_multicastDests.GetValue ( dest );
+		pHealth->consecutiveFailures = 0;
+		pHealth->skipMs = 0UL;
+	}
+}
+
+/**
+ * @brief Returns the outbound multicast queue, for statistics display.
+ * @return Reference to the queue drained by ProcessSendQueue().
+ */
+const OutboundPacketQueue& UDPWiFiService::GetSendQueue () const
+{
+	return m_sendQueue;
+}
+
 /**
  * @brief Returns the cumulative count of unicast reply packets sent.
  * @return Number of reply packets successfully transmitted via SendReply().
@@ -888,13 +1483,89 @@ uint32_t UDPWiFiService::GetReplySentCount ()
 }
 
 /**
- * @brief Returns a pointer to the list of known multicast/broadcast destination addresses.
- * @return Pointer to the FixedIPList populated with subnet broadcast addresses discovered
- *         from incoming UDP senders and the device's own subnet.
+ * @brief Returns the time taken to answer the most recent request.
+ * @return Microseconds from parsePacket() of the request to the successful SendReply(), or 0 if
+ *         no request has been answered yet.
+ */
+uint32_t UDPWiFiService::GetLastReplyLatencyUs () const
+{
+	return m_ulLastReplyLatencyUs;
+}
+
+/**
+ * @brief Returns the worst request-to-reply time seen since boot.
+ * @return Maximum microseconds from parsePacket() to the successful SendReply().
+ */
+uint32_t UDPWiFiService::GetMaxReplyLatencyUs () const
+{
+	return m_ulMaxReplyLatencyUs;
+}
+
+/**
+ * @brief Returns the number of packets taken by the most recent CheckUDP() call.
+ * @return Packets drained in the last call, discarded ones included, in the range
+ *         [0, UDP_DRAIN_MAX_PACKETS].
+ */
+uint8_t UDPWiFiService::GetLastDrainCount () const
+{
+	return m_lastDrained;
+}
+
+/**
+ * @brief Returns the most packets taken by a single CheckUDP() call since boot.
+ * @return Peak packets drained per call, in the range [0, UDP_DRAIN_MAX_PACKETS].
+ */
+uint8_t UDPWiFiService::GetMaxDrainCount () const
+{
+	return m_maxDrained;
+}
+
+/**
+ * @brief Returns how often CheckUDP() handled its full UDP_DRAIN_MAX_PACKETS quota.
+ * @details A steadily rising value means more requests were waiting; consider raising the limit.
+ * @return Count of calls that stopped at the packet limit.
+ */
+uint32_t UDPWiFiService::GetDrainLimitReachedCount () const
+{
+	return m_ulDrainLimitReached;
+}
+
+/**
+ * @brief Returns how often CheckUDP() stopped draining because UDP_DRAIN_BUDGET_US ran out.
+ * @return Count of calls that ended on the time budget before reaching the packet limit.
+ */
+uint32_t UDPWiFiService::GetDrainBudgetExhaustedCount () const
+{
+	return m_ulDrainBudgetExhausted;
+}
+
+/**
+ * @brief Returns the number of multicast destination set operations in the last minute.
+ * @return Add(), Unpin(), Expire() and send-path iterations counted over the last complete
+ *         DEST_LIST_STATS_MS window; the status screen's own reads are not counted.
  */
-FixedIPList* UDPWiFiService::GetMulticastList ()
+uint32_t UDPWiFiService::GetDestListOpsPerMinute () const
 {
-	return m_pMulticastDestList;
+	return m_ulDestListOpsPerMin;
+}
+
+/**
+ * @brief Returns how often failed multicasts were passed on to link recovery.
+ * @return Count of send failures that found every destination failing and disconnected WiFi.
+ */
+uint32_t UDPWiFiService::GetDestEscalationCount () const
+{
+	return m_ulDestEscalations;
+}
+
+/**
+ * @brief Returns the set of known multicast/broadcast destination addresses.
+ * @return The subnet broadcast addresses of recent UDP senders and the device's own subnet,
+ *         each with its DestHealth send statistics.
+ */
+const UDPWiFiService::MulticastDestSet& UDPWiFiService::GetMulticastList () const
+{
+	return m_multicastDests;
 }
 
 /// @brief Releases UDP port and disconnects from WiFi
@@ -902,76 +1573,66 @@ void UDPWiFiService::Stop ()
 {
 	Info ( "Stopping WiFI" );
 	m_myUDP.stop();
+	SetLinkState ( LinkState::IDLE );
 	WiFiDisconnect();
 }
 
-/// @brief Processes the UDP message that has been received
-/// @param sRecvMessage String containing the messade received
-void UDPWiFiService::ProcessUDPMessage ( const String& sRecvMessage )
+/**
+ * @brief Decodes the message code of a version 1 request without allocating.
+ * @details Validates the "V001:" prefix, loads the following four bytes as one packed integer,
+ *          checks them against the "M00n" family in a single compare and maps the final digit
+ *          through MsgCodeTable. Bytes after the code are ignored, as before.
+ * @param pMsg Null-terminated message text.
+ * @param len  Length of the message in bytes.
+ * @param bVersionOK Output: true if the message carried the "V001:" prefix.
+ * @return A ReqMsgType value, DECODE_RESTART or DECODE_UNKNOWN.
+ */
+uint8_t UDPWiFiService::DecodeV1Request ( const char* pMsg, size_t len, bool& bVersionOK )
 {
-	if ( sRecvMessage.startsWith ( cMsgVersion1 ) )
+	bVersionOK = len >= MSG_VERSION_LEN && memcmp ( pMsg, cMsgVersion1Prefix, MSG_VERSION_LEN ) == 0;
+	if ( !bVersionOK || len < MSG_VERSION_LEN + MSG_CODE_LEN )
 	{
-		// Version 1 message received
-		if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		         .startsWith ( TempHumidityReqMsg ) )
-		{
-			// Got a data request
-			// Error ( "Temp Data request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::TEMPDATA );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( RestartReqMsg ) )
-		{
-			// Got a reset request
-			MN::Utils::ResetBoard ( F ( "Reset request" ) );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( DoorStatusReqMsg ) )
-		{
-			// Got a door status request
-			// Error ( "Door Data request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::DOORDATA );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( DoorOpenReqMsg ) )
-		{
-			// Error ( "Door Open request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::DOOROPEN );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( DoorCloseReqMsg ) )
-		{
-			// Error ( "Door Close request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::DOORCLOSE );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( DoorStopReqMsg ) )
-		{
-			// Error ( "Door Stop request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::DOORSTOP );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( DoorLightOnReqMsg ) )
-		{
-			// Error ( "Light On request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::LIGHTON );
-		}
-		else if ( sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 2 )
-		              .startsWith ( DoorLightOffReqMsg ) )
-		{
-			// Info ( "Light Off request" );
-			m_MsgHandlerCallback ( UDPWiFiService::ReqMsgType::LIGHTOFF );
-		}
-		else
-		{
-			m_ulBadRequests++;
-			Error ( "Unknown request : " +
-			        sRecvMessage.substring ( sizeof ( cMsgVersion1 ) + sizeof ( PartSeparator ) - 1 ) );
-		}
+		return DECODE_UNKNOWN;
 	}
-	else
+	const char* pCode = pMsg + MSG_VERSION_LEN;
+	uint32_t code = PackMsgCode ( pCode [ 0 ], pCode [ 1 ], pCode [ 2 ], pCode [ 3 ] );
+	uint8_t digit = (uint8_t)( ( code >> 24 ) - '0' );
+	if ( ( code & MSG_CODE_FAMILY_MASK ) != MSG_CODE_FAMILY || digit > 9 )
+	{
+		return DECODE_UNKNOWN;
+	}
+	return MsgCodeTable [ digit ];
+}
+
+/**
+ * @brief Processes the UDP request that has been received.
+ * @details Decoding is a prefix compare and one table lookup (see DecodeV1Request()), so the
+ *          cost is the same for every message type and nothing is allocated on the good path.
+ * @param pRecvMessage Null-terminated message text.
+ * @param len          Length of the message in bytes.
+ */
+void UDPWiFiService::ProcessUDPMessage ( const char* pRecvMessage, size_t len )
+{
+	bool bVersionOK;
+	uint8_t decoded = DecodeV1Request ( pRecvMessage, len, bVersionOK );
+
+	if ( !bVersionOK )
 	{
 		m_ulBadMgsVersion++;
-		Error ( "Unknown message version : " + sRecvMessage );
+		Error ( String ( "Unknown message version : " ) + pRecvMessage );
+	}
+	else if ( decoded == DECODE_RESTART )
+	{
+		// Got a reset request
+		MN::Utils::ResetBoard ( F ( "Reset request" ) );
+	}
+	else if ( decoded == DECODE_UNKNOWN )
+	{
+		m_ulBadRequests++;
+		Error ( String ( "Unknown request : " ) + ( pRecvMessage + MSG_VERSION_LEN ) );
+	}
+	else
+	{
+		m_MsgHandlerCallback ( static_cast<UDPWiFiService::ReqMsgType> ( decoded ) );
 	}
 }
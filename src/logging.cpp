@@ -2,7 +2,7 @@
 
 Logging.cpp
 
-Implements logging.h
+Implements Logging.h
 
 if MNDEBUG is defined then output is sent to the Serial port else it is not compiled.
 
@@ -15,8 +15,13 @@ Author: (c) M. Naylor 2022
 
 History:
     Ver 1.0			Initial version
+    Ver 1.1			Shadow-buffer diff rendering, per-frame byte count, exact ClearPartofLine
+    Ver 1.2			CTelnet collects output in a transmit buffer sent by flush()
+    Ver 1.3			CTelnet accepts clients in Poll(), not in the write path
+    Ver 1.4			IsClientConnected()/ReadyForFrame(); a slow Telnet client keeps its backlog
+    Ver 1.5			CTelnet drops a client whose backlog has not shrunk for TELNET_STALL_TIMEOUT_MS
 */
-#include "logging.h"
+#include "Logging.h"
 
 namespace MN ::Utils
 {
@@ -49,45 +54,71 @@ void ResetBoard ( const __FlashStringHelper* pErrMsg )
 #endif
 }  // namespace MN::Utils
 
+ansiVT220Logger* ansiVT220Logger::ms_pScreen = nullptr;
+
+/**
+ * @brief Returns the character a cell shows for a character of text.
+ * @param ch Character to print.
+ * @return ch, or a space for control characters, which would move the cursor.
+ */
+static char CellChar ( char ch )
+{
+	return (uint8_t)ch < ' ' || ch == 0x7F ? ' ' : ch;
+}
+
+/**
+ * @brief Constructs the logger with a blank shadow screen.
+ * @param logger Transport the escape sequences are written to.
+ */
+ansiVT220Logger::ansiVT220Logger ( Logger& logger ) : m_logger ( logger )
+{
+	ResetShadow();
+}
+
 /**
  * @brief Sends an ANSI escape sequence to clear the entire terminal screen.
+ * @details The shadow screen is reset to match, so everything drawn afterwards is sent.
  */
 void ansiVT220Logger::ClearScreen ()
 {
-	m_logger.print ( CLEAR_SCREEN );
+	m_bRepaint = false;
+	Emit ( RESET_COLOURS );
+	Emit ( CLEAR_SCREEN );
+	ResetShadow();
 }
 
 /**
- * @brief Moves the terminal cursor to the specified position and prints a string.
+ * @brief Prints a string at the specified position in the terminal's default colours.
+ * @details Only the cells that differ from what the terminal already shows are sent.
  * @param row Screen row (1-based; 0 is treated as 1).
  * @param col Screen column (1-based; 0 is treated as 1).
- * @param s   String to print at that position.
+ * @param s   String to print at that position; clipped at the right-hand edge.
  */
 void ansiVT220Logger::AT ( uint8_t row, uint8_t col, String s )
 {
-	row = row == 0 ? 1 : row;
-	col = col == 0 ? 1 : col;
-	String m = String ( CSI ) + row + String ( ";" ) + col + String ( "H" ) + s;
-	m_logger.print ( m );
+	RepaintIfNeeded();
+	WriteCells ( row, col, s.c_str(), s.length() > MAX_COLS ? MAX_COLS : s.length(), ATTR_DEFAULT );
 }
 
 /**
- * @brief Sets foreground/background colours, moves the cursor, prints a string,
- *        then resets the terminal colours to default.
+ * @brief Prints a string in the given colours at the specified position.
+ * @details Only the cells that differ from what the terminal already shows, in
+ *          character or colour, are sent; the colours stay selected until a cell
+ *          needs different ones.
  * @param FGColour Foreground colour (ansiVT220Logger::colours enum value).
  * @param BGColour Background colour (ansiVT220Logger::colours enum value).
  * @param row      Screen row (1-based).
  * @param col      Screen column (1-based).
- * @param s        String to print.
+ * @param s        String to print; clipped at the right-hand edge.
  */
 void ansiVT220Logger::COLOUR_AT ( colours FGColour, colours BGColour, uint8_t row, uint8_t col, String s )
 {
-	// set colours
-
-	m_logger.print ( String ( CSI ) + FGColour + ";" + BGColour + "m" );
-	AT ( row, col, s );
-	// reset colours
-	m_logger.print ( RESET_COLOURS );
+	RepaintIfNeeded();
+	WriteCells ( row,
+	             col,
+	             s.c_str(),
+	             s.length() > MAX_COLS ? MAX_COLS : s.length(),
+	             MakeAttr ( FGColour, BGColour ) );
 }
 
 /**
@@ -95,7 +126,8 @@ void ansiVT220Logger::COLOUR_AT ( colours FGColour, colours BGColour, uint8_t ro
  */
 void ansiVT220Logger::RestoreCursor ( void )
 {
-	m_logger.print ( RESTORE_CURSOR );
+	Emit ( RESTORE_CURSOR );
+	m_cursorRow = CURSOR_UNKNOWN;
 }
 
 /**
@@ -103,51 +135,332 @@ void ansiVT220Logger::RestoreCursor ( void )
  */
 void ansiVT220Logger::SaveCursor ( void )
 {
-	m_logger.print ( SAVE_CURSOR );
+	Emit ( SAVE_CURSOR );
 }
 
 /**
- * @brief Saves the cursor, clears the entire specified screen row, then restores the cursor.
+ * @brief Clears the entire specified screen row. See ClearPartofLine().
  * @param row Screen row (1-based) to clear.
  */
 void ansiVT220Logger::ClearLine ( uint8_t row )
 {
-	SaveCursor();
-	AT ( row, 1, String ( CLEAR_LINE ) );
-	RestoreCursor();
+	ClearPartofLine ( row, 1, MAX_COLS );
 }
 
 /**
- * @brief Saves the cursor, overwrites a portion of a screen row with spaces, then
- *        restores the cursor.
+ * @brief Marks part of a screen row to be blanked at the end of the frame.
+ * @details Nothing is sent now. Cells written before EndFrame() are no longer
+ *          blanked, so clearing a field and rewriting the same value costs nothing;
+ *          EndFrame() sends spaces for the rest, if they are not blank already.
  * @param row       Screen row (1-based) containing the region to clear.
- * @param start_col Starting column (1-based) of the region.
- * @param toclear   Number of characters to overwrite with spaces.
+ * @param start_col Starting column (1-based; 0 is treated as 1) of the region.
+ * @param toclear   Number of characters to clear; stops at the end of the row.
  */
 void ansiVT220Logger::ClearPartofLine ( uint8_t row, uint8_t start_col, uint8_t toclear )
 {
-	static char buf [ ansiVT220Logger::MAX_COLS + 1 ];
-	memset ( buf, ' ', sizeof ( buf ) - 1 );
-	buf [ ansiVT220Logger::MAX_COLS ] = 0;
+	row = row == 0 ? 1 : row;
+	start_col = start_col == 0 ? 1 : start_col;
+	if ( row > MAX_ROWS || start_col > MAX_COLS )
+	{
+		return;
+	}
+	uint16_t end = (uint16_t)start_col - 1 + toclear;
+	if ( end > MAX_COLS )
+	{
+		end = MAX_COLS;
+	}
+	uint8_t* pBits = m_pendingClear [ row - 1 ];
+	for ( uint16_t c = start_col - 1; c < end; c++ )
+	{
+		pBits [ c / 8 ] |= (uint8_t)( 1U << ( c % 8 ) );
+	}
+}
+
+/**
+ * @brief Completes a frame: blanks the cells still marked by ClearPartofLine(),
+ *        flushes the transport and records the number of bytes sent since the
+ *        previous frame.
+ * @details Also leaves the terminal in its default colours, so that anything else
+ *          written to the transport is not coloured by the last field.
+ */
+void ansiVT220Logger::EndFrame ()
+{
+	char spaces [ MAX_COLS ];
+	memset ( spaces, ' ', sizeof ( spaces ) );
+	RepaintIfNeeded();
+	for ( uint8_t r = 0; r < MAX_ROWS; r++ )
+	{
+		const uint8_t* pBits = m_pendingClear [ r ];
+		uint8_t c = 0;
+		while ( c < MAX_COLS )
+		{
+			if ( ( pBits [ c / 8 ] & ( 1U << ( c % 8 ) ) ) == 0 )
+			{
+				c++;
+				continue;
+			}
+			uint8_t start = c;
+			while ( c < MAX_COLS && ( pBits [ c / 8 ] & ( 1U << ( c % 8 ) ) ) != 0 )
+			{
+				c++;
+			}
+			WriteCells ( r + 1, start + 1, spaces, c - start, ATTR_DEFAULT );
+		}
+	}
+	SetAttr ( ATTR_DEFAULT );
+	m_logger.flush();
+
+	m_ulLastFrameBytes = m_ulFrameBytes;
+	if ( m_ulFrameBytes > m_ulMaxFrameBytes )
+	{
+		m_ulMaxFrameBytes = m_ulFrameBytes;
+	}
+	m_ulFrameBytes = 0UL;
+}
+
+/**
+ * @brief Gives the transport a chance to accept a client. See Logger::Poll().
+ */
+void ansiVT220Logger::Poll ()
+{
+	m_logger.Poll();
+}
+
+/**
+ * @brief Returns whether anyone can see the output. See Logger::IsClientConnected().
+ */
+bool ansiVT220Logger::IsClientConnected ()
+{
+	return m_logger.IsClientConnected();
+}
+
+/**
+ * @brief Sends output still queued from the last frame and reports whether all of it has gone.
+ * @details A client that has not taken the last frame yet would only have more
+ *          queued for it, so the display skips frames until this returns true.
+ * @return true when nothing is left queued for the client.
+ */
+bool ansiVT220Logger::ReadyForFrame ()
+{
+	m_logger.flush();
+	return m_logger.GetPendingBytes() == 0;
+}
+
+/**
+ * @brief Returns the number of bytes sent to the transport during the last complete frame.
+ */
+uint32_t ansiVT220Logger::GetLastFrameBytes () const
+{
+	return m_ulLastFrameBytes;
+}
+
+/**
+ * @brief Returns the largest number of bytes sent during one frame since boot.
+ */
+uint32_t ansiVT220Logger::GetMaxFrameBytes () const
+{
+	return m_ulMaxFrameBytes;
+}
+
+/**
+ * @brief Writes a run of characters into the shadow screen, sending only the cells that change.
+ * @details Cells that already hold the same character and colours are skipped;
+ *          gaps of up to MAX_REWRITE_GAP unchanged cells between changed ones are
+ *          re-sent, which is cheaper than a cursor move. Writing a cell cancels any
+ *          pending clear of it.
+ * @param row   Screen row (1-based; 0 is treated as 1).
+ * @param col   Screen column (1-based; 0 is treated as 1).
+ * @param pText Characters to write.
+ * @param len   Number of characters; clipped at the right-hand edge.
+ * @param attr  Cell attribute (see MakeAttr()).
+ */
+void ansiVT220Logger::WriteCells ( uint8_t row, uint8_t col, const char* pText, uint8_t len, uint8_t attr )
+{
+	row = row == 0 ? 1 : row;
+	col = col == 0 ? 1 : col;
+	if ( row > MAX_ROWS || col > MAX_COLS )
+	{
+		return;
+	}
+	uint8_t r = row - 1;
+	uint8_t c0 = col - 1;
+	if ( len > MAX_COLS - c0 )
+	{
+		len = MAX_COLS - c0;
+	}
+	char* pChars = m_shadowChars [ r ];
+	uint8_t* pAttrs = m_shadowAttrs [ r ];
+	uint8_t* pBits = m_pendingClear [ r ];
+
+	uint8_t i = 0;
+	while ( i < len )
+	{
+		// skip cells the terminal already shows
+		for ( ; i < len; i++ )
+		{
+			uint8_t c = c0 + i;
+			char ch = CellChar ( pText [ i ] );
+			pBits [ c / 8 ] &= (uint8_t) ~( 1U << ( c % 8 ) );
+			if ( pChars [ c ] != ch || pAttrs [ c ] != attr )
+			{
+				break;
+			}
+		}
+		if ( i == len )
+		{
+			break;
+		}
+
+		// extend the run over changed cells and short unchanged gaps
+		uint8_t start = i;
+		uint8_t end = i + 1;  // one past the last changed cell
+		for ( uint8_t j = end; j < len && j - end < MAX_REWRITE_GAP; j++ )
+		{
+			uint8_t c = c0 + j;
+			char ch = CellChar ( pText [ j ] );
+			pBits [ c / 8 ] &= (uint8_t) ~( 1U << ( c % 8 ) );
+			if ( pChars [ c ] != ch || pAttrs [ c ] != attr )
+			{
+				end = j + 1;
+			}
+		}
+
+		char run [ MAX_COLS ];
+		for ( uint8_t j = start; j < end; j++ )
+		{
+			uint8_t c = c0 + j;
+			char ch = CellChar ( pText [ j ] );
+			run [ j - start ] = ch;
+			pChars [ c ] = ch;
+			pAttrs [ c ] = attr;
+		}
+		MoveTo ( r, c0 + start );
+		SetAttr ( attr );
+		Emit ( run, end - start );
+		// the cursor stays on the last column after writing it, until the next character wraps
+		m_cursorCol = c0 + end < MAX_COLS ? c0 + end : CURSOR_UNKNOWN;
+		i = end;
+	}
+}
+
+/**
+ * @brief Moves the terminal cursor, unless it is already there.
+ * @param row Screen row (0-based).
+ * @param col Screen column (0-based).
+ */
+void ansiVT220Logger::MoveTo ( uint8_t row, uint8_t col )
+{
+	if ( m_cursorRow == row && m_cursorCol == col )
+	{
+		return;
+	}
+	char buf [ 12 ];
+	int len = snprintf ( buf, sizeof ( buf ), "\x1b[%u;%uH", row + 1U, col + 1U );
+	Emit ( buf, len );
+	m_cursorRow = row;
+	m_cursorCol = col;
+}
 
-	// build string of toclear spaces
-	toclear %= ansiVT220Logger::MAX_COLS + 1;  // ensure toclear is <= MAX_COLS
-	if ( start_col + toclear > ansiVT220Logger::MAX_COLS + 1 )
+/**
+ * @brief Selects the colours of a cell attribute, unless they are already selected.
+ * @param attr Cell attribute (see MakeAttr()).
+ */
+void ansiVT220Logger::SetAttr ( uint8_t attr )
+{
+	if ( m_currentAttr == attr )
 	{
-		toclear = ansiVT220Logger::MAX_COLS - start_col + 1;
+		return;
+	}
+	if ( attr == ATTR_DEFAULT )
+	{
+		Emit ( RESET_COLOURS );
+	}
+	else
+	{
+		uint8_t fg = attr >> 4;
+		uint8_t bg = attr & 0x0F;
+		char buf [ 12 ];
+		int len = snprintf ( buf,
+		                     sizeof ( buf ),
+		                     "\x1b[%u;%um",
+		                     (unsigned)( fg < 8 ? FG_BLACK + fg : FG_BRIGHTBLACK + fg - 8 ),
+		                     (unsigned)( bg < 8 ? BG_BLACK + bg : BG_BRIGHTBLACK + bg - 8 ) );
+		Emit ( buf, len );
+	}
+	m_currentAttr = attr;
+}
+
+/**
+ * @brief Packs a foreground and background colour into a cell attribute.
+ * @param FGColour Foreground colour.
+ * @param BGColour Background colour.
+ * @return Foreground index (0-15) in the high nibble, background index in the low.
+ */
+uint8_t ansiVT220Logger::MakeAttr ( colours FGColour, colours BGColour )
+{
+	uint8_t fg = FGColour >= FG_BRIGHTBLACK ? FGColour - FG_BRIGHTBLACK + 8 : FGColour - FG_BLACK;
+	uint8_t bg = BGColour >= BG_BRIGHTBLACK ? BGColour - BG_BRIGHTBLACK + 8 : BGColour - BG_BLACK;
+	return (uint8_t)( ( ( fg & 0x0F ) << 4 ) | ( bg & 0x0F ) );
+}
+
+/**
+ * @brief Sends bytes to the transport and adds them to the frame byte count.
+ * @details If a connected client's transport could not take them all, the screen
+ *          is cleared and repainted from the next write.
+ * @param pData Bytes to send.
+ * @param len   Number of bytes.
+ */
+void ansiVT220Logger::Emit ( const char* pData, size_t len )
+{
+	m_ulFrameBytes += len;
+	if ( m_logger.write ( (const uint8_t*)pData, len ) < len && m_logger.IsClientConnected() )
+	{
+		// output was lost, so the terminal no longer shows what the shadow holds
+		m_bRepaint = true;
+	}
+}
+
+/**
+ * @brief Sends a String to the transport and adds it to the frame byte count.
+ * @param s String to send.
+ */
+void ansiVT220Logger::Emit ( const String& s )
+{
+	Emit ( s.c_str(), s.length() );
+}
+
+/**
+ * @brief Sets the shadow screen to blank cells in default colours, with nothing
+ *        pending and the cursor position and colours unknown.
+ */
+void ansiVT220Logger::ResetShadow ()
+{
+	memset ( m_shadowChars, ' ', sizeof ( m_shadowChars ) );
+	memset ( m_shadowAttrs, ATTR_DEFAULT, sizeof ( m_shadowAttrs ) );
+	memset ( m_pendingClear, 0, sizeof ( m_pendingClear ) );
+	m_cursorRow = CURSOR_UNKNOWN;
+	m_cursorCol = CURSOR_UNKNOWN;
+	m_currentAttr = ATTR_UNKNOWN;
+}
+
+/**
+ * @brief Clears the screen if a client has connected since the last write.
+ * @details A new client's terminal shows none of what the shadow screen holds, so
+ *          the screen is cleared and everything is sent again as it is redrawn.
+ */
+void ansiVT220Logger::RepaintIfNeeded ()
+{
+	if ( m_bRepaint )
+	{
+		ClearScreen();
 	}
-	toclear = ( ansiVT220Logger::MAX_COLS - start_col + 1 ) %
-	          ( ansiVT220Logger::MAX_COLS + 1 );  // ensure toclear doesn't go past end of line
-	SaveCursor();
-	buf [ toclear ] = 0;
-	AT ( row, start_col, buf );
-	RestoreCursor();
 }
 
 /**
  * @brief Callback invoked by the logger backend when a client connects to the terminal.
  * @details Configures the terminal to 132-column mode, sets the window title to
- *          "GarageControl Debug", and enables 63-line page mode.
+ *          "GarageControl Debug", and enables 63-line page mode, then has the next
+ *          write clear the screen and repaint it from scratch.
  * @param plog Pointer to the Logger (transport) instance for the new connection.
  */
 void ansiVT220Logger::OnClientConnect ( void* plog )
@@ -156,6 +469,10 @@ void ansiVT220Logger::OnClientConnect ( void* plog )
 	pLog->print ( SCREEN_SIZE132 );
 	pLog->print ( ansiVT220Logger::OSC + "2;GarageControl Debug\x1b\\" + STRING_TERMINATOR );
 	pLog->print ( F ( "\x1b[63;2\"p" ) );
+	if ( ms_pScreen != nullptr )
+	{
+		ms_pScreen->m_bRepaint = true;
+	}
 }
 
 /**
@@ -167,6 +484,7 @@ void ansiVT220Logger::LogStart ()
 	m_logger.LogStart();
 	if ( m_logger.CanDetectClientConnect() )
 	{
+		ms_pScreen = this;
 		m_logger.SetConnectCallback ( &ansiVT220Logger::OnClientConnect );
 	}
 }
@@ -283,32 +601,14 @@ void CTelnet::begin ( uint32_t port )
 	m_pmyServer->begin();
 }
 
+/**
+ * @brief Queues a single byte for the Telnet client. See write(const uint8_t*, size_t).
+ * @param c The byte to write.
+ * @return 1 if queued, 0 if there is no client.
+ */
 size_t CTelnet::write ( uint8_t c )
 {
-	size_t result = 0;
-	if ( m_myClient.connected() )
-	{
-		size_t result = m_myClient.write ( c );
-		if ( result <= 0 )
-		{
-			m_myClient.stop();
-			m_bClientConnected = false;
-			// Serial.println ( "Client disconnected" );
-		}
-	}
-	else
-	{
-		if ( m_pmyServer != nullptr )
-		{
-			m_myClient = m_pmyServer->available();
-			if ( m_myClient )
-			{
-				// Serial.println ( "Client connected" );
-				m_bClientConnected = true;
-			}
-		}
-	}
-	return result;
+	return write ( &c, 1 );
 }
 
 /**
@@ -332,62 +632,173 @@ void CTelnet::DoConnect ()
 	}
 }
 
-size_t CTelnet::write ( const uint8_t* buffer, size_t size )
+/**
+ * @brief Accepts a waiting Telnet client, if there is one, at most every TELNET_ACCEPT_POLL_MS.
+ * @details Looking for a client is an SPI transaction with the NINA module, so it
+ *          is done here, once per period, rather than on every write. Nothing is
+ *          done while a client is connected; a client that goes away is noticed by
+ *          flush().
+ */
+void CTelnet::Poll ()
 {
-	size_t result = 0;
-	if ( m_myClient.connected() && size > 0 )
+	uint32_t ulNow = millis();
+	if ( m_bClientConnected || ulNow - m_ulLastAcceptMs < TELNET_ACCEPT_POLL_MS )
 	{
-		size_t result = m_myClient.write ( (char*)buffer, size );
-		if ( result <= 0 )
+		return;
+	}
+	m_ulLastAcceptMs = ulNow;
+	Accept();
+}
+
+/**
+ * @brief Accepts a waiting Telnet client, if there is one, and fires the connect callback.
+ */
+void CTelnet::Accept ()
+{
+	if ( m_pmyServer != nullptr )
+	{
+		m_myClient = m_pmyServer->available();
+		if ( m_myClient )
 		{
-			m_myClient.stop();
-			m_bClientConnected = false;
-			// Serial.println ( "Client disconnected" );
+			// Serial.println ( "Client connected" );
+			m_bClientConnected = true;
+			m_txLen = 0;
+			m_ulLastProgressMs = millis();
+			DoConnect();
 		}
 	}
-	else
+}
+
+/**
+ * @brief Queues bytes for the Telnet client.
+ * @details Bytes are collected in a TELNET_TX_BUFFER_SIZE buffer and sent by
+ *          flush(), which is called when the buffer fills and at the end of each
+ *          display frame, so a frame goes out in a few full TCP segments rather than
+ *          one per field. If there is no client the bytes are discarded at once
+ *          (clients are accepted by Poll()). If the client is not taking data, so
+ *          the buffer cannot be emptied, the bytes that do not fit are discarded.
+ * @param buffer Pointer to the bytes to write.
+ * @param size   Number of bytes to write.
+ * @return Number of bytes queued.
+ */
+size_t CTelnet::write ( const uint8_t* buffer, size_t size )
+{
+	if ( !m_bClientConnected )
 	{
-		if ( m_pmyServer != nullptr )
+		return 0;
+	}
+	size_t queued = 0;
+	while ( queued < size )
+	{
+		if ( m_txLen == TELNET_TX_BUFFER_SIZE )
 		{
-			m_myClient = m_pmyServer->available();
-			if ( m_myClient )
+			flush();
+			if ( !m_bClientConnected || m_txLen == TELNET_TX_BUFFER_SIZE )
 			{
-				// Serial.println ( "Client connected" );
-				m_bClientConnected = true;
-				DoConnect();
+				break;
 			}
 		}
+		size_t chunk = size - queued;
+		if ( chunk > TELNET_TX_BUFFER_SIZE - m_txLen )
+		{
+			chunk = TELNET_TX_BUFFER_SIZE - m_txLen;
+		}
+		memcpy ( m_txBuffer + m_txLen, buffer + queued, chunk );
+		m_txLen += chunk;
+		queued += chunk;
 	}
-	return result;
+	return queued;
 }
 
+/**
+ * @brief Queues a String for the Telnet client. See write(const uint8_t*, size_t).
+ * @param Msg The string to write.
+ * @return Number of bytes queued.
+ */
 size_t CTelnet::write ( String Msg )
 {
-	size_t Result = 0;
-	if ( m_myClient.connected() && Msg.length() > 0 )
+	return write ( (const uint8_t*)Msg.c_str(), Msg.length() );
+}
+
+/**
+ * @brief Sends the queued bytes to the Telnet client in one write.
+ * @details If the client has gone it is dropped along with the queued bytes. If it
+ *          takes only part, or nothing, the rest stays queued for the next flush. A
+ *          client that is still connected but has taken nothing for
+ *          TELNET_STALL_TIMEOUT_MS is dropped too, as Poll() accepts no other client
+ *          while it holds the connection.
+ */
+void CTelnet::flush ()
+{
+	if ( !m_bClientConnected )
+	{
+		return;
+	}
+	if ( m_txLen == 0 )
 	{
-		Result = m_myClient.print ( Msg );
-		if ( Result <= 0 )
+		m_ulLastProgressMs = millis();
+		return;
+	}
+	if ( !m_myClient.connected() )
+	{
+		m_myClient.stop();
+		m_bClientConnected = false;
+		m_txLen = 0;
+		// Serial.println ( "Client disconnected" );
+		return;
+	}
+	size_t sent = m_myClient.write ( m_txBuffer, m_txLen );
+	if ( sent == 0 )
+	{
+		if ( millis() - m_ulLastProgressMs >= TELNET_STALL_TIMEOUT_MS )
 		{
 			m_myClient.stop();
 			m_bClientConnected = false;
-			// Serial.println ( "Client disconnected" );
+			m_txLen = 0;
+			// Serial.println ( "Client stalled" );
 		}
+		return;
 	}
-	else
+	m_ulLastProgressMs = millis();
+	m_ulFlushes++;
+	m_ulFlushedBytes += sent;
+	if ( sent < m_txLen )
 	{
-		if ( m_pmyServer != nullptr )
-		{
-			m_myClient = m_pmyServer->available();
-			if ( m_myClient )
-			{
-				// Serial.println ( "Client connected" );
-				m_bClientConnected = true;
-				DoConnect();
-			}
-		}
+		memmove ( m_txBuffer, m_txBuffer + sent, m_txLen - sent );
 	}
-	return Result;
+	m_txLen -= sent;
+}
+
+/**
+ * @brief Returns whether a Telnet client is connected.
+ */
+bool CTelnet::IsClientConnected ()
+{
+	return m_bClientConnected;
+}
+
+/**
+ * @brief Returns the number of bytes queued for the Telnet client that flush() has not sent.
+ */
+size_t CTelnet::GetPendingBytes ()
+{
+	return m_txLen;
+}
+
+/**
+ * @brief Returns the number of writes to the Telnet client since boot.
+ */
+uint32_t CTelnet::GetFlushCount () const
+{
+	return m_ulFlushes;
+}
+
+/**
+ * @brief Returns the average number of bytes sent per write to the Telnet client.
+ */
+uint32_t CTelnet::GetAverageFlushBytes () const
+{
+	return m_ulFlushes == 0 ? 0UL : m_ulFlushedBytes / m_ulFlushes;
 }
 
 /**